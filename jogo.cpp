@@ -3,14 +3,47 @@
 #include "C:\Seu_Diretorio_aqui\jogo_personagens.cpp"
 #include <locale>
 
-int main(void) {
+// Uso: jogo [opções]                          partida pela entrada padrão (terminal, arquivo ou pipe)
+//      jogo [opções] roteiro.txt [--silencioso]  todas as partidas do roteiro (separadas por "---"), sem gravar replay
+// Opções: --metricas arquivo   liga o comando "metricas", que grava as métricas do processo no arquivo
+//         --gravar arquivo     grava a partida interativa no arquivo, para o jogo_repetidor reproduzir
+int main(int argc, char **argv) {
     // Define a localidade para pt_BR com codificação UTF-8
     setlocale(LC_ALL, "pt_BR.UTF-8");
 
-    //inicializa o jogo
-    Game game;
-    game.run();
-    return 0;
+    //inicializa o jogo (usa a história compilada se existir; senão, a embutida no código)
+    Game game("historia.bin");
+    int arg = 1;
+    for (; arg < argc && std::string(argv[arg]).rfind("--", 0) == 0; arg += 2) {
+        std::string opcao = argv[arg];
+        if (arg + 1 >= argc) {
+            std::cerr << "Falta o arquivo de " << opcao << "\n";
+            return 1;
+        }
+        if (opcao == "--metricas")
+            game.setMetricsPath(argv[arg + 1]);
+        else if (opcao == "--gravar")
+            game.setReplayPath(argv[arg + 1]);
+        else {
+            std::cerr << "Opção desconhecida: " << opcao << "\n";
+            return 1;
+        }
+    }
+    if (arg >= argc) {
+        game.run();
+        return 0;
+    }
+
+    InputHandler roteiro;
+    if (!roteiro.open(argv[arg])) {
+        std::cerr << "Não foi possível abrir o roteiro " << argv[arg] << "\n";
+        return 1;
+    }
+    if (arg + 1 < argc && std::string(argv[arg + 1]) == "--silencioso")
+        game.setOutput(-1);
+    size_t partidas = game.runScript(roteiro);
+    std::cerr << partidas << " partidas jogadas\n";
+    return roteiro.getStatus() == InputHandler::Status::Error ? 1 : 0;
 
 /*
     // Define a localidade para pt_BR com codificação UTF-8
@@ -0,0 +1,333 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "jogo_historia.cpp"
+
+/*
+StoryAnalysis
+Função: Analisa o grafo da história uma única vez, logo depois de ele ser carregado, e guarda os resultados para o motor consultar: cenas alcançáveis a partir do início, escolhas que apontam para cenas inexistentes, finais (cenas marcadas com ::final ou sem escolhas) e escolhas que saem de um final para o meio da história, ciclos, menor caminho do início até cada cena e distância de cada cena até o final mais próximo.
+Todas as etapas percorrem cada cena e cada escolha um número constante de vezes (O(cenas + escolhas)), sem recursão, então a análise continua rápida e sem estourar a pilha em histórias com milhões de cenas.
+Nos ciclos e no "maior caminho", as escolhas que saem de um final ("jogar de novo") não contam como continuação da história. O maior caminho é medido sobre o grafo em que cada ciclo restante é contado como um único passo (componentes fortemente conexos), pois com ciclos um caminho pode ser tão longo quanto o jogador quiser.
+*/
+class StoryAnalysis {
+    public:
+        static constexpr int UNREACHABLE = -1;
+
+        struct ChoiceRef {
+            int sceneId;
+            int choiceIndex; // Começando em 0
+            int targetSceneId;
+        };
+
+        // Analisa "graph"; os resultados anteriores são descartados
+        void analyze(const StoryGraph &graph) {
+            *this = StoryAnalysis();
+            slots = graph.getSceneSlots();
+            if (!graph.isLoaded() || slots == 0)
+                return;
+            startId = graph.getStartSceneId();
+            buildReverse(graph);
+            findShortestPaths(graph);
+            findDistanceToEnding();
+            findCycles(graph);
+            findLongestPaths(graph);
+        }
+
+        bool isAnalyzed() const { return slots > 0; }
+        int getSceneCount() const { return sceneCount; }
+
+        // Cena alcançável a partir da cena inicial
+        bool isReachable(int id) const { return inRange(id) && shortest[id] != UNREACHABLE; }
+
+        // Menor quantidade de escolhas do início até a cena (UNREACHABLE se não houver caminho)
+        int getShortestFromStart(int id) const { return inRange(id) ? shortest[id] : UNREACHABLE; }
+
+        // Cena anterior no menor caminho a partir do início (-1 para o início ou cenas inalcançáveis)
+        int getShortestPredecessor(int id) const { return inRange(id) ? predecessor[id] : -1; }
+
+        // Menor quantidade de escolhas até uma cena final (UNREACHABLE se nenhum final puder ser atingido)
+        int getDistanceToEnding(int id) const { return inRange(id) ? toEnding[id] : UNREACHABLE; }
+
+        // Maior quantidade de escolhas do início até a cena, contando cada ciclo como um passo
+        int getLongestFromStart(int id) const { return inRange(id) ? longest[id] : UNREACHABLE; }
+
+        // Cena faz parte de um ciclo (inclui cenas com escolha para si mesmas)
+        bool isInCycle(int id) const { return inRange(id) && cyclic[id]; }
+
+        const std::vector<int> &getEndings() const { return endings; }
+        const std::vector<int> &getUnreachable() const { return unreachable; }
+        const std::vector<ChoiceRef> &getDangling() const { return dangling; }
+
+        // Escolhas de um final que levam a uma cena diferente da inicial (ex.: "Não" do game over)
+        const std::vector<ChoiceRef> &getEndingExits() const { return endingExits; }
+
+        // Ciclos encontrados, cada um com as cenas do componente
+        const std::vector<std::vector<int>> &getCycles() const { return cycles; }
+
+        // Menor caminho do início até a cena, incluindo as duas pontas (vazio se for inalcançável)
+        std::vector<int> getShortestPath(int id) const {
+            std::vector<int> path;
+            if (!isReachable(id))
+                return path;
+            for (int at = id; at != -1; at = predecessor[at])
+                path.push_back(at);
+            return std::vector<int>(path.rbegin(), path.rend());
+        }
+
+        // Relatório legível de tudo o que foi encontrado
+        void printReport(std::ostream &out) const {
+            out << "Cenas: " << sceneCount << ", escolhas: " << edgeCount << ", cena inicial: " << startId << "\n";
+            for (const ChoiceRef &d : dangling)
+                out << "Aviso: a escolha " << (d.choiceIndex + 1) << " da cena " << d.sceneId
+                    << " aponta para a cena inexistente " << d.targetSceneId << "\n";
+            for (const ChoiceRef &d : endingExits)
+                out << "Aviso: a escolha " << (d.choiceIndex + 1) << " do final " << d.sceneId
+                    << " leva à cena " << d.targetSceneId << ", não ao início\n";
+            if (!unreachable.empty()) {
+                out << "Cenas inalcançáveis:";
+                for (int id : unreachable)
+                    out << " " << id;
+                out << "\n";
+            }
+            for (const std::vector<int> &cycle : cycles) {
+                out << "Ciclo entre as cenas:";
+                for (int id : cycle)
+                    out << " " << id;
+                out << "\n";
+            }
+            for (int id : endings) {
+                out << "Final " << id << ": ";
+                if (!isReachable(id)) {
+                    out << "inalcançável\n";
+                    continue;
+                }
+                out << "menor caminho " << shortest[id] << " escolha(s) (";
+                std::vector<int> path = getShortestPath(id);
+                for (size_t i = 0; i < path.size(); i++)
+                    out << (i ? " " : "") << path[i];
+                out << "), maior caminho " << longest[id] << "\n";
+            }
+            int semSaida = 0;
+            for (int id = 0; id < slots; id++)
+                if (isReachable(id) && toEnding[id] == UNREACHABLE)
+                    semSaida++;
+            if (semSaida > 0)
+                out << "Aviso: " << semSaida << " cena(s) alcançável(is) sem caminho para nenhum final\n";
+        }
+
+    private:
+        bool inRange(int id) const { return id >= 0 && id < slots; }
+
+        // Arestas invertidas em formato compacto (CSR), só entre cenas existentes
+        void buildReverse(const StoryGraph &graph) {
+            reverseStart.assign(slots + 1, 0);
+            for (int id = 0; id < slots; id++) {
+                if (!graph.hasScene(id))
+                    continue;
+                sceneCount++;
+                int first = graph.getFirstChoice(id);
+                int count = graph.getChoiceCount(id);
+                edgeCount += count;
+                bool ending = graph.isEnding(id);
+                if (ending)
+                    endings.push_back(id);
+                for (int e = first; e < first + count; e++) {
+                    int target = graph.getEdgeTarget(e);
+                    if (graph.hasScene(target))
+                        reverseStart[target + 1]++;
+                    else
+                        dangling.push_back({id, e - first, target});
+                    if (ending && graph.hasScene(target) && target != startId)
+                        endingExits.push_back({id, e - first, target});
+                }
+            }
+            for (int id = 0; id < slots; id++)
+                reverseStart[id + 1] += reverseStart[id];
+            reverseEdges.resize(reverseStart[slots]);
+            std::vector<int> fill(reverseStart.begin(), reverseStart.end() - 1);
+            for (int id = 0; id < slots; id++) {
+                if (!graph.hasScene(id))
+                    continue;
+                int first = graph.getFirstChoice(id);
+                for (int e = first; e < first + graph.getChoiceCount(id); e++) {
+                    int target = graph.getEdgeTarget(e);
+                    if (graph.hasScene(target))
+                        reverseEdges[fill[target]++] = id;
+                }
+            }
+        }
+
+        // Busca em largura a partir do início
+        void findShortestPaths(const StoryGraph &graph) {
+            shortest.assign(slots, UNREACHABLE);
+            predecessor.assign(slots, -1);
+            if (!graph.hasScene(startId))
+                return;
+            std::vector<int> queue;
+            queue.reserve(sceneCount);
+            shortest[startId] = 0;
+            queue.push_back(startId);
+            for (size_t head = 0; head < queue.size(); head++) {
+                int id = queue[head];
+                int first = graph.getFirstChoice(id);
+                for (int e = first; e < first + graph.getChoiceCount(id); e++) {
+                    int target = graph.getEdgeTarget(e);
+                    if (graph.hasScene(target) && shortest[target] == UNREACHABLE) {
+                        shortest[target] = shortest[id] + 1;
+                        predecessor[target] = id;
+                        queue.push_back(target);
+                    }
+                }
+            }
+            for (int id = 0; id < slots; id++)
+                if (graph.hasScene(id) && shortest[id] == UNREACHABLE)
+                    unreachable.push_back(id);
+        }
+
+        // Busca em largura nas arestas invertidas, partindo de todos os finais ao mesmo tempo
+        void findDistanceToEnding() {
+            toEnding.assign(slots, UNREACHABLE);
+            std::vector<int> queue(endings);
+            queue.reserve(sceneCount);
+            for (int id : endings)
+                toEnding[id] = 0;
+            for (size_t head = 0; head < queue.size(); head++) {
+                int id = queue[head];
+                for (int r = reverseStart[id]; r < reverseStart[id + 1]; r++) {
+                    int from = reverseEdges[r];
+                    if (toEnding[from] == UNREACHABLE) {
+                        toEnding[from] = toEnding[id] + 1;
+                        queue.push_back(from);
+                    }
+                }
+            }
+        }
+
+        // Tarjan iterativo: a pilha explícita guarda a cena e a próxima escolha a visitar
+        void findCycles(const StoryGraph &graph) {
+            component.assign(slots, -1);
+            cyclic.assign(slots, false);
+            std::vector<int> index(slots, -1), low(slots, 0);
+            std::vector<int> stack, callScene, callEdge;
+            std::vector<bool> onStack(slots, false);
+            int nextIndex = 0;
+            componentCount = 0;
+
+            for (int root = 0; root < slots; root++) {
+                if (!graph.hasScene(root) || index[root] != -1)
+                    continue;
+                callScene.push_back(root);
+                callEdge.push_back(graph.getFirstChoice(root));
+                index[root] = low[root] = nextIndex++;
+                stack.push_back(root);
+                onStack[root] = true;
+
+                while (!callScene.empty()) {
+                    int id = callScene.back();
+                    int &e = callEdge.back();
+                    int end = graph.getFirstChoice(id) + (graph.isEnding(id) ? 0 : graph.getChoiceCount(id));
+                    bool descended = false;
+                    while (e < end) {
+                        int target = graph.getEdgeTarget(e++);
+                        if (!graph.hasScene(target))
+                            continue;
+                        if (target == id)
+                            cyclic[id] = true;
+                        if (index[target] == -1) {
+                            index[target] = low[target] = nextIndex++;
+                            stack.push_back(target);
+                            onStack[target] = true;
+                            callScene.push_back(target);
+                            callEdge.push_back(graph.getFirstChoice(target));
+                            descended = true;
+                            break;
+                        }
+                        if (onStack[target] && index[target] < low[id])
+                            low[id] = index[target];
+                    }
+                    if (descended)
+                        continue;
+
+                    // Todas as escolhas de "id" foram visitadas
+                    if (low[id] == index[id]) {
+                        size_t begin = stack.size();
+                        do {
+                            begin--;
+                        } while (stack[begin] != id);
+                        if (stack.size() - begin > 1) {
+                            cycles.emplace_back(stack.begin() + begin, stack.end());
+                            for (size_t i = begin; i < stack.size(); i++)
+                                cyclic[stack[i]] = true;
+                        } else if (cyclic[id]) {
+                            cycles.push_back({id});
+                        }
+                        for (size_t i = begin; i < stack.size(); i++) {
+                            onStack[stack[i]] = false;
+                            component[stack[i]] = componentCount;
+                        }
+                        stack.resize(begin);
+                        componentCount++;
+                    }
+                    callScene.pop_back();
+                    callEdge.pop_back();
+                    if (!callScene.empty()) {
+                        int parent = callScene.back();
+                        if (low[id] < low[parent])
+                            low[parent] = low[id];
+                    }
+                }
+            }
+        }
+
+        // Tarjan numera os componentes em ordem topológica inversa: percorrendo do maior número para o
+        // menor, cada componente é processado depois de todos os que levam a ele
+        void findLongestPaths(const StoryGraph &graph) {
+            longest.assign(slots, UNREACHABLE);
+            if (!graph.hasScene(startId))
+                return;
+            std::vector<int> componentStart(componentCount + 1, 0), members(sceneCount);
+            for (int id = 0; id < slots; id++)
+                if (component[id] >= 0)
+                    componentStart[component[id] + 1]++;
+            for (int c = 0; c < componentCount; c++)
+                componentStart[c + 1] += componentStart[c];
+            std::vector<int> fill(componentStart.begin(), componentStart.end() - 1);
+            for (int id = 0; id < slots; id++)
+                if (component[id] >= 0)
+                    members[fill[component[id]]++] = id;
+
+            std::vector<int> best(componentCount, UNREACHABLE);
+            best[component[startId]] = 0;
+            for (int c = componentCount - 1; c >= 0; c--) {
+                if (best[c] == UNREACHABLE)
+                    continue;
+                for (int m = componentStart[c]; m < componentStart[c + 1]; m++) {
+                    int id = members[m];
+                    longest[id] = best[c];
+                    if (graph.isEnding(id))
+                        continue;
+                    int first = graph.getFirstChoice(id);
+                    for (int e = first; e < first + graph.getChoiceCount(id); e++) {
+                        int target = graph.getEdgeTarget(e);
+                        if (!graph.hasScene(target) || component[target] == c)
+                            continue;
+                        if (best[component[target]] < best[c] + 1)
+                            best[component[target]] = best[c] + 1;
+                    }
+                }
+            }
+        }
+
+        int slots = 0;
+        int startId = 1;
+        int sceneCount = 0;
+        int edgeCount = 0;
+        int componentCount = 0;
+        std::vector<int> reverseStart, reverseEdges;
+        std::vector<int> shortest, predecessor, toEnding, longest, component;
+        std::vector<bool> cyclic;
+        std::vector<int> endings, unreachable;
+        std::vector<ChoiceRef> dangling, endingExits;
+        std::vector<std::vector<int>> cycles;
+};
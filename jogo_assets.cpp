@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ArtHandle
+Função: Referência compacta para uma arte do AssetRegistry (o índice dela). Cenas podem guardar o handle no lugar do texto.
+*/
+struct ArtHandle {
+    static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+    uint32_t index = INVALID;
+
+    bool isValid() const { return index != INVALID; }
+};
+
+/*
+AssetRegistry
+Função: Guarda cada ASCII art uma única vez e entrega visões (std::string_view) dela, sem cópias. Depois de freeze() o registro é imutável e pode ser compartilhado por todas as cenas, jogos e threads do processo.
+A busca por nome usa um hash perfeito calculado em freeze(): uma semente é escolhida de modo que nenhum par de nomes caia na mesma posição da tabela, então cada consulta custa um hash e uma única comparação de texto.
+*/
+class AssetRegistry {
+    public:
+        // Os nomes e textos apontam para "owned", que só sobrevive intacto a um move
+        AssetRegistry() = default;
+        AssetRegistry(AssetRegistry &&) = default;
+        AssetRegistry &operator=(AssetRegistry &&) = default;
+        AssetRegistry(const AssetRegistry &) = delete;
+        AssetRegistry &operator=(const AssetRegistry &) = delete;
+
+        // Registra uma arte (antes de freeze); um nome repetido substitui o texto anterior
+        ArtHandle add(std::string_view name, std::string_view text) {
+            return borrow(owned.emplace_back(name), owned.emplace_back(text));
+        }
+
+        // Registra uma arte sem copiar nome nem texto: eles precisam viver mais que o registro (ex.: ARTES_PADRAO, que
+        // fica nos dados somente leitura do executável e é dividido entre os processos pelo cache de páginas)
+        ArtHandle borrow(std::string_view name, std::string_view text) {
+            ArtHandle handle = findLinear(name);
+            if (handle.isValid()) {
+                texts[handle.index] = text;
+                return handle;
+            }
+            handle.index = static_cast<uint32_t>(names.size());
+            names.push_back(name);
+            texts.push_back(text);
+            return handle;
+        }
+
+        // Calcula a tabela de hash perfeito; as buscas por nome só funcionam depois daqui
+        void freeze() {
+            size_t size = 1;
+            while (size < names.size() * 2)
+                size <<= 1;
+            mask = static_cast<uint32_t>(size - 1);
+            for (seed = 0;; seed++) {
+                table.assign(size, ArtHandle::INVALID);
+                bool perfect = true;
+                for (uint32_t i = 0; i < names.size() && perfect; i++) {
+                    uint32_t &slot = table[hash(names[i], seed) & mask];
+                    perfect = slot == ArtHandle::INVALID;
+                    slot = i;
+                }
+                if (perfect)
+                    break;
+                if (seed % 64 == 63) {
+                    // Tabela cheia demais para achar uma semente rapidamente: dobra o tamanho
+                    size <<= 1;
+                    mask = static_cast<uint32_t>(size - 1);
+                }
+            }
+        }
+
+        ArtHandle find(std::string_view name) const {
+            ArtHandle handle;
+            if (table.empty())
+                return handle;
+            uint32_t index = table[hash(name, seed) & mask];
+            if (index != ArtHandle::INVALID && names[index] == name)
+                handle.index = index;
+            return handle;
+        }
+
+        std::string_view get(ArtHandle handle) const {
+            return handle.isValid() ? texts[handle.index] : std::string_view();
+        }
+
+        // Texto da arte pelo nome; vazio se ela não existir
+        std::string_view operator[](std::string_view name) const { return get(find(name)); }
+
+        size_t size() const { return names.size(); }
+        std::string_view getName(ArtHandle handle) const { return names[handle.index]; }
+
+    private:
+        // FNV-1a com semente
+        static uint32_t hash(std::string_view text, uint32_t seed) {
+            uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+            for (char c : text) {
+                h ^= static_cast<unsigned char>(c);
+                h *= 16777619u;
+            }
+            return h ^ (h >> 15);
+        }
+
+        ArtHandle findLinear(std::string_view name) const {
+            ArtHandle handle;
+            for (uint32_t i = 0; i < names.size(); i++)
+                if (names[i] == name)
+                    handle.index = i;
+            return handle;
+        }
+
+        // Cópias feitas por add; deque: elas não mudam de endereço quando novas artes são registradas
+        std::deque<std::string> owned;
+        std::vector<std::string_view> names;
+        std::vector<std::string_view> texts;
+        std::vector<uint32_t> table;
+        uint32_t mask = 0;
+        uint32_t seed = 0;
+};
@@ -0,0 +1,252 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+#include "jogo_combate.cpp"
+#include "jogo_compressao.cpp"
+#include "jogo_historia_padrao.cpp"
+#include "jogo_personagens.cpp"
+
+/*
+Benchmark das rolagens de dados.
+Compara o roll_dice antigo (srand(time(0)) + rand() % n a cada chamada) com o gerador Dados,
+tanto rolagem a rolagem quanto em lote. Compile com otimização (ex.: cl /O2 /EHsc ou g++ -O2);
+o lote só é vetorizado de fato com instruções largas habilitadas (/arch:AVX2 ou -march=native).
+Também mede uma rodada de 10.000 combatentes (5.000 contra 5.000) em Combatentes, comparada com
+o mesmo combate feito por objetos FormaDeVida separados no heap, e o custo do despacho virtual
+(FormaDeVida::atacar, SerHumano::responda) contra o estático (Personagem com std::visit).
+Por fim, comprime as artes padrão com o ArtCodec e mede a taxa de compressão e a vazão da
+descompressão direto em um buffer de quadro, comparada com a cópia das artes sem compressão.
+*/
+
+// Cópia da implementação original de roll_dice, mantida apenas como referência de desempenho
+int roll_dice_legado(int dice_num)
+{
+    switch (dice_num)
+    {
+    case 2: case 4: case 6: case 8: case 10: case 12: case 20: case 100:
+        srand(time(0));
+        dice_num = rand() % dice_num + 1;
+        break;
+
+    default:
+        break;
+    }
+    return dice_num;
+}
+
+// Mede "funcao" chamada "n" vezes e imprime as operações (rolagens, por padrão) por segundo
+template <class Funcao>
+void medir(const char *nome, size_t n, Funcao &&funcao, const char *plural = "rolagens", const char *singular = "rolagem")
+{
+    auto inicio = std::chrono::steady_clock::now();
+    long long soma = funcao(n);
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    std::cout << nome << ": " << n / segundos / 1e6 << " milhões de " << plural << "/s"
+              << " (" << segundos * 1e9 / n << " ns/" << singular << ", soma " << soma << ")\n";
+}
+
+// Ataques e falas pelos mesmos personagens, uma vez pela API virtual e outra pelo Personagem
+void medirDespacho()
+{
+    std::vector<Personagem> grupo;
+    for (int i = 0; i < 1000; i++) {
+        switch (i % 4) {
+        case 0: grupo.emplace_back(Cavaleiro("Cavaleiro")); break;
+        case 1: grupo.emplace_back(Mago("Mago")); break;
+        case 2: grupo.emplace_back(Aldeao("Aldeao")); break;
+        default: grupo.emplace_back(Dragao("Dragao")); break;
+        }
+    }
+    std::vector<FormaDeVida *> formas;
+    std::vector<SerHumano *> humanos;
+    std::vector<size_t> indicesHumanos;
+    for (size_t i = 0; i < grupo.size(); i++) {
+        formas.push_back(&formaDeVida(grupo[i]));
+        if (SerHumano *h = dynamic_cast<SerHumano *>(formas.back())) {
+            humanos.push_back(h);
+            indicesHumanos.push_back(i);
+        }
+    }
+    const int repeticoes = 2000;
+    Dados dados(7);
+    Monstro alvo("Alvo");
+
+    medir("Ataque virtual (FormaDeVida&)", grupo.size() * repeticoes, [&](size_t) {
+        long long soma = 0;
+        for (int r = 0; r < repeticoes; r++) {
+            for (FormaDeVida *f : formas) {
+                alvo.setVida(100);
+                soma += f->atacar(alvo, dados);
+            }
+        }
+        return soma;
+    }, "ataques", "ataque");
+    dados.semear(7);
+    medir("Ataque estático (Personagem)", grupo.size() * repeticoes, [&](size_t) {
+        long long soma = 0;
+        for (int r = 0; r < repeticoes; r++) {
+            for (Personagem &p : grupo) {
+                alvo.setVida(100);
+                soma += atacar(p, alvo, dados);
+            }
+        }
+        return soma;
+    }, "ataques", "ataque");
+
+    const char *falas[] = {"Olá!", "Tudo bem?", "Sim, e você?", "Até logo!", "Tchau!"};
+    medir("Fala virtual (SerHumano::responda)", humanos.size() * repeticoes, [&](size_t) {
+        long long soma = 0;
+        for (int r = 0; r < repeticoes; r++)
+            for (SerHumano *h : humanos)
+                soma += h->responda(falas[r % 5]).size();
+        return soma;
+    }, "falas", "fala");
+    medir("Fala estática (Personagem)", humanos.size() * repeticoes, [&](size_t) {
+        long long soma = 0;
+        for (int r = 0; r < repeticoes; r++)
+            for (size_t i : indicesHumanos)
+                soma += responder(grupo[i], falas[r % 5]).size();
+        return soma;
+    }, "falas", "fala");
+
+    // Mesmas falas já internadas: a conversa real (conversar) anda assim, só com ids
+    const Dialogos &dialogos = dialogos_padrao();
+    uint32_t ids[5];
+    for (int i = 0; i < 5; i++)
+        ids[i] = dialogos.procurar(falas[i]);
+    std::vector<uint32_t> tabelas;
+    for (size_t i : indicesHumanos)
+        tabelas.push_back(std::visit([](auto &c) {
+            using Classe = std::decay_t<decltype(c)>;
+            if constexpr (std::is_base_of_v<SerHumano, Classe>)
+                return SerHumano::tabelaDialogo<Classe>();
+            else
+                return Dialogos::SEM_FALA;
+        }, grupo[i]));
+    medir("Fala por id (Dialogos)", tabelas.size() * repeticoes, [&](size_t) {
+        long long soma = 0;
+        for (int r = 0; r < repeticoes; r++)
+            for (uint32_t tabela : tabelas)
+                soma += dialogos.texto(dialogos.responder(tabela, ids[r % 5])).size();
+        return soma;
+    }, "falas", "fala");
+}
+
+// Taxa de compressão das artes padrão e vazão (GB/s de texto) ao montá-las em um quadro
+void medirArtes()
+{
+    std::vector<std::string> comprimidas;
+    size_t original = 0, comprimido = 0;
+    for (const FixedArt &art : ARTES_PADRAO) {
+        comprimidas.push_back(ArtCodec::compress(art.text));
+        original += art.text.size();
+        comprimido += comprimidas.back().size();
+        if (ArtCodec::decode(comprimidas.back()) != art.text)
+            std::cout << "A arte " << art.name << " não confere depois de descomprimida\n";
+    }
+    std::cout << "Artes padrão: " << original << " bytes -> " << comprimido << " comprimidos (taxa "
+              << static_cast<double>(original) / comprimido << ":1)\n";
+
+    const int repeticoes = 20000;
+    std::string quadro;
+    quadro.reserve(original);
+    auto vazao = [&](const char *nome, auto &&montar) {
+        auto inicio = std::chrono::steady_clock::now();
+        size_t soma = 0;
+        for (int r = 0; r < repeticoes; r++) {
+            quadro.clear();
+            montar();
+            soma += static_cast<unsigned char>(quadro[r % quadro.size()]);
+        }
+        double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        std::cout << nome << ": " << static_cast<double>(original) * repeticoes / segundos / 1e9 << " GB/s"
+                  << " (" << segundos * 1e9 / repeticoes << " ns/quadro, soma " << soma << ")\n";
+    };
+    vazao("ArtCodec::appendDecoded", [&] {
+        for (const std::string &c : comprimidas)
+            ArtCodec::appendDecoded(quadro, c);
+    });
+    vazao("Cópia sem compressão", [&] {
+        for (const FixedArt &art : ARTES_PADRAO)
+            quadro.append(art.text);
+    });
+}
+
+int main(void)
+{
+    const size_t n = 20000000;
+    const int faces = d20;
+
+    medir("roll_dice antigo", n / 10, [&](size_t total) {
+        long long soma = 0;
+        for (size_t i = 0; i < total; i++)
+            soma += roll_dice_legado(faces);
+        return soma;
+    });
+
+    Dados dados(42);
+    medir("Dados::rolar", n, [&](size_t total) {
+        long long soma = 0;
+        for (size_t i = 0; i < total; i++)
+            soma += dados.rolar(faces);
+        return soma;
+    });
+
+    std::vector<int> buffer(4096);
+    dados.semear(42);
+    medir("Dados::rolarLote", n, [&](size_t total) {
+        long long soma = 0;
+        for (size_t feitas = 0; feitas < total; feitas += buffer.size()) {
+            dados.rolarLote(faces, buffer.data(), buffer.size());
+            for (int valor : buffer)
+                soma += valor;
+        }
+        return soma;
+    });
+
+    const uint32_t lado = 5000;
+    const int rodadas = 2000;
+    Combatentes combate;
+    Combatentes::Grupo herois = combate.adicionar(lado, 100, 10, 100);
+    Combatentes::Grupo horda = combate.adicionar(lado, 100, 6, 100);
+    auto inicio = std::chrono::steady_clock::now();
+    for (int r = 0; r < rodadas; r++) {
+        combate.rodada(herois, horda, dados);
+        combate.rodada(horda, herois, dados);
+        combate.curar(herois, 20);
+        combate.curar(horda, 20);
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    std::cout << "Combatentes (" << 2 * lado << " por rodada): " << segundos * 1e6 / rodadas << " us/rodada"
+              << " (vivos " << combate.contarVivos(herois) << " x " << combate.contarVivos(horda) << ")\n";
+
+    std::vector<std::unique_ptr<Cavaleiro>> ladoA;
+    std::vector<std::unique_ptr<Monstro>> ladoB;
+    for (uint32_t i = 0; i < lado; i++) {
+        ladoA.push_back(std::make_unique<Cavaleiro>("Cavaleiro"));
+        ladoB.push_back(std::make_unique<Monstro>("Orgo"));
+    }
+    inicio = std::chrono::steady_clock::now();
+    for (int r = 0; r < rodadas / 10; r++) {
+        for (uint32_t i = 0; i < lado; i++)
+            if (ladoA[i]->estaVivo())
+                ladoA[i]->atacar(*ladoB[i], dados);
+        for (uint32_t i = 0; i < lado; i++)
+            if (ladoB[i]->estaVivo())
+                ladoB[i]->atacar(*ladoA[i], dados);
+        for (uint32_t i = 0; i < lado; i++) {
+            ladoA[i]->setVida(ladoA[i]->estaVivo() ? ladoA[i]->getVida() + 20 : 0);
+            ladoB[i]->setVida(ladoB[i]->estaVivo() ? ladoB[i]->getVida() + 20 : 0);
+        }
+    }
+    segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    std::cout << "FormaDeVida no heap (" << 2 * lado << " por rodada): " << segundos * 1e6 / (rodadas / 10) << " us/rodada\n";
+
+    medirDespacho();
+    medirArtes();
+    return 0;
+}
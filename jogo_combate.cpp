@@ -0,0 +1,150 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "jogo_dados.cpp"
+
+const float VIDA_MAXIMA = 100.0f;
+const float FATOR_PROTECAO = 0.6f; // Parte do dano que chega a um combatente protegido (como no escudo do Cavaleiro)
+
+/*
+Combatentes
+Função: Guarda os combatentes de lutas grandes (o grupo de heróis contra hordas de Monstro/Orgo) em vetores contíguos, um por atributo (vida, dano, forca e proteção), no lugar de um objeto no heap por combatente.
+Cada grupo ocupa uma faixa contínua dos vetores, e dano, cura e limite de vida são laços simples sobre a faixa inteira, sem desvios e sem chamadas virtuais, que o compilador vetoriza. Uma rodada entre grupos de milhares de combatentes leva microssegundos.
+Os vetores de trabalho da rodada são reaproveitados, então as rodadas não alocam depois que os grupos foram criados.
+*/
+class Combatentes
+{
+public:
+  struct Grupo
+  {
+    uint32_t inicio = 0;
+    uint32_t tamanho = 0;
+  };
+
+  // Acrescenta "quantidade" combatentes iguais e devolve a faixa deles
+  Grupo adicionar(uint32_t quantidade, float vidaInicial, float danoBase, float forcaInicial)
+  {
+    Grupo grupo{static_cast<uint32_t>(vida.size()), quantidade};
+    vida.resize(vida.size() + quantidade, std::min(std::max(vidaInicial, 0.0f), VIDA_MAXIMA));
+    dano.resize(dano.size() + quantidade, danoBase);
+    forca.resize(forca.size() + quantidade, forcaInicial);
+    fatorDano.resize(fatorDano.size() + quantidade, 1.0f);
+    rolagens.resize(std::max<size_t>(rolagens.size(), quantidade));
+    ataques.resize(std::max<size_t>(ataques.size(), quantidade));
+    golpes.resize(std::max<size_t>(golpes.size(), quantidade));
+    return grupo;
+  }
+
+  // Remove todos os combatentes, mantendo a memória para a próxima luta
+  void limpar()
+  {
+    vida.clear();
+    dano.clear();
+    forca.clear();
+    fatorDano.clear();
+  }
+
+  void setProtecao(Grupo g, bool protegido)
+  {
+    std::fill_n(fatorDano.data() + g.inicio, g.tamanho, protegido ? FATOR_PROTECAO : 1.0f);
+  }
+
+  // Mesmo dano para todo o grupo (armadilhas, ataques em área)
+  void aplicarDano(Grupo g, float valor)
+  {
+    float *v = vida.data() + g.inicio;
+    const float *f = fatorDano.data() + g.inicio;
+    for (uint32_t i = 0; i < g.tamanho; i++)
+      v[i] = std::max(v[i] - valor * f[i], 0.0f);
+  }
+
+  // Dano individual: valores[i] vai para o i-ésimo combatente do grupo
+  void aplicarDano(Grupo g, const float *valores)
+  {
+    float *v = vida.data() + g.inicio;
+    const float *f = fatorDano.data() + g.inicio;
+    for (uint32_t i = 0; i < g.tamanho; i++)
+      v[i] = std::max(v[i] - valores[i] * f[i], 0.0f);
+  }
+
+  // Cura só os vivos, sem passar da vida máxima
+  void curar(Grupo g, float valor)
+  {
+    float *v = vida.data() + g.inicio;
+    for (uint32_t i = 0; i < g.tamanho; i++)
+      v[i] = v[i] > 0.0f ? std::min(v[i] + valor, VIDA_MAXIMA) : 0.0f;
+  }
+
+  // Regras do setVida aplicadas ao grupo inteiro: vida entre 0 e 100
+  void limitarVida(Grupo g)
+  {
+    float *v = vida.data() + g.inicio;
+    for (uint32_t i = 0; i < g.tamanho; i++)
+      v[i] = std::min(std::max(v[i], 0.0f), VIDA_MAXIMA);
+  }
+
+  /* Uma rodada de ataques: cada combatente vivo de "atacantes" causa dano + d20 * forca / 100
+  (o ataque do jogo_encontros, com a forca em porcentagem) e os golpes são distribuídos em rodízio
+  entre os "alvos", vivos ou não, a partir de um alvo sorteado. As rolagens saem em lote do gerador
+  da luta. */
+  void rodada(Grupo atacantes, Grupo alvos, Dados &dados)
+  {
+    if (atacantes.tamanho == 0 || alvos.tamanho == 0)
+      return;
+    const uint32_t n = atacantes.tamanho;
+    const uint32_t m = alvos.tamanho;
+    dados.rolarLote(d20, rolagens.data(), n);
+
+    const float *v = vida.data() + atacantes.inicio;
+    const float *d = dano.data() + atacantes.inicio;
+    const float *f = forca.data() + atacantes.inicio;
+    float *a = ataques.data();
+    for (uint32_t i = 0; i < n; i++)
+      a[i] = (v[i] > 0.0f ? 1.0f : 0.0f) * (d[i] + static_cast<float>(rolagens[i]) * f[i] * 0.01f);
+
+    float *g = golpes.data();
+    std::fill_n(g, m, 0.0f);
+    for (uint32_t k = 0; k < n; k += m)
+    {
+      uint32_t parte = std::min(m, n - k);
+      for (uint32_t j = 0; j < parte; j++)
+        g[j] += a[k + j];
+    }
+    // O golpe g[j] vai para o alvo (inicio + j) % m: duas faixas contínuas
+    uint32_t inicio = static_cast<uint32_t>(dados.rolar(static_cast<int>(m)) - 1);
+    aplicarDano(Grupo{alvos.inicio + inicio, m - inicio}, g);
+    aplicarDano(Grupo{alvos.inicio, inicio}, g + (m - inicio));
+  }
+
+  uint32_t contarVivos(Grupo g) const
+  {
+    const float *v = vida.data() + g.inicio;
+    uint32_t vivos = 0;
+    for (uint32_t i = 0; i < g.tamanho; i++)
+      vivos += v[i] > 0.0f ? 1 : 0;
+    return vivos;
+  }
+
+  float vidaTotal(Grupo g) const
+  {
+    const float *v = vida.data() + g.inicio;
+    float total = 0.0f;
+    for (uint32_t i = 0; i < g.tamanho; i++)
+      total += v[i];
+    return total;
+  }
+
+  float getVida(uint32_t i) const { return vida[i]; }
+  size_t tamanho() const { return vida.size(); }
+
+private:
+  std::vector<float> vida;
+  std::vector<float> dano;
+  std::vector<float> forca;
+  std::vector<float> fatorDano; // 1 ou FATOR_PROTECAO
+  std::vector<int> rolagens;
+  std::vector<float> ataques;
+  std::vector<float> golpes;
+};
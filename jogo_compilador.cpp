@@ -0,0 +1,65 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "jogo_engine.cpp"
+
+/*
+Compilador de histórias
+Função: Converte o formato de texto de autoria (ver StoryCompiler em jogo_historia.cpp) no arquivo binário que o Game carrega com Game("historia.bin").
+Também pode gravar a história padrão embutida no programa (HISTORIA_PADRAO, gerada durante a compilação a partir das tabelas de jogo_historia_padrao.cpp).
+
+Uso:
+    jogo_compilador historia.txt historia.bin
+    jogo_compilador --embutida historia.bin
+*/
+
+int main(int argc, char **argv)
+{
+    if (argc != 3) {
+        std::cerr << "Uso: " << argv[0] << " <historia.txt | --embutida> <saida.bin>\n";
+        return 1;
+    }
+    std::string entrada = argv[1];
+    std::string saida = argv[2];
+
+    std::vector<char> bytes;
+    if (entrada == "--embutida") {
+        const char *imagem = static_cast<const char *>(HISTORIA_PADRAO.data());
+        bytes.assign(imagem, imagem + HISTORIA_PADRAO.size());
+    } else {
+        std::ifstream in(entrada, std::ios::binary);
+        if (!in) {
+            std::cerr << "Não foi possível abrir " << entrada << "\n";
+            return 1;
+        }
+        StoryCompiler compiler;
+        std::string error;
+        if (!compiler.parse(in, error)) {
+            std::cerr << entrada << ": " << error << "\n";
+            return 1;
+        }
+        bytes = compiler.build();
+    }
+
+    std::ofstream out(saida, std::ios::binary);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    out.close();
+    if (!out) {
+        std::cerr << "Não foi possível gravar " << saida << "\n";
+        return 1;
+    }
+
+    // Confere o arquivo gerado carregando-o como o jogo faria e mostra a análise do grafo
+    StoryGraph story;
+    if (!story.load(saida)) {
+        std::cerr << "O arquivo gerado não pôde ser carregado\n";
+        return 1;
+    }
+    StoryAnalysis analysis;
+    analysis.analyze(story);
+    analysis.printReport(std::cout);
+    std::cout << saida << ": " << analysis.getSceneCount() << " cenas"
+              << (analysis.getDangling().empty() ? "" : ", " + std::to_string(analysis.getDangling().size()) + " escolha(s) sem destino") << "\n";
+    return 0;
+}
@@ -0,0 +1,262 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ArtCodec
+Função: Compressão das ASCII arts para o arquivo da história. As artes são quase só sequências de espaços, traços repetidos e linhas parecidas, então um LZ77 simples orientado a bytes, com referências para trás dentro da própria arte, já as reduz à metade. Uma referência à distância 1 é uma sequência de um mesmo caractere (o caso das margens de espaços).
+A decodificação escreve direto no buffer do quadro (appendDecoded): o tamanho final vem no início do bloco, o buffer cresce uma vez e cada trecho é um memcpy de tamanho fixo (literais e referências distantes) ou um memset (sequências de um caractere), sem passar byte a byte. Como no LZ4, cada sequência junta literais e uma referência em um único token, então há um desvio a cada dez e poucos bytes do texto, não um por byte.
+Formato:
+
+    tamanho decodificado (inteiro de tamanho variável, 7 bits por byte)
+    sequências:
+        token          LLLL MMMM: L literais e uma cópia de M + MIN_MATCH bytes (15 em L ou M: mais bytes de tamanho)
+        [+ 255...]     bytes somados a L enquanto valerem 255
+        literais
+        distância (u16)  de onde copiar, para trás; a última sequência termina nos literais, sem referência
+        [+ 255...]     bytes somados a M enquanto valerem 255
+*/
+class ArtCodec {
+    public:
+        static constexpr size_t MIN_MATCH = 4;
+        static constexpr size_t WINDOW = 65535;
+        static constexpr size_t WILD_COPY = 8;
+        static constexpr size_t MAX_DECODED = 1 << 20; // Maior arte aceita (1 MiB); textos maiores não são comprimidos
+        static constexpr size_t MAX_EXPANSION = 255;   // Cada byte comprimido gera no máximo 255 bytes de texto
+
+        // constexpr para que as histórias em tabelas constexpr (jogo_historia_fixa.cpp) também tenham as artes
+        // comprimidas durante a compilação, com o mesmo resultado que o jogo_compilador grava
+        static constexpr std::string compress(std::string_view text) {
+            std::string out;
+            putSize(out, text.size());
+            const size_t n = text.size();
+            // Cadeias de posições com os mesmos 4 primeiros bytes (hash de 12 bits)
+            std::vector<int32_t> head(1 << 12, -1);
+            std::vector<int32_t> prev(n, -1);
+            size_t anchor = 0; // Início dos literais ainda não gravados
+            size_t i = 0;
+            while (i < n) {
+                size_t distance = 0;
+                size_t length = longestMatch(text, head, prev, i, distance);
+                // Avaliação preguiçosa: se a próxima posição tem uma referência mais longa, esta vira literal
+                if (length >= MIN_MATCH && i + 1 < n) {
+                    insert(head, prev, text, i);
+                    size_t proximaDistancia = 0;
+                    if (longestMatch(text, head, prev, i + 1, proximaDistancia) > length) {
+                        i++;
+                        continue;
+                    }
+                } else {
+                    insert(head, prev, text, i);
+                }
+                if (length < MIN_MATCH) {
+                    i++;
+                    continue;
+                }
+                putSequence(out, text.substr(anchor, i - anchor), length, distance);
+                for (size_t k = 1; k < length; k++)
+                    insert(head, prev, text, i + k);
+                i += length;
+                anchor = i;
+            }
+            if (anchor < n || n == 0)
+                putSequence(out, text.substr(anchor), 0, 0);
+            return out;
+        }
+
+        // Tamanho do texto decodificado; 0 se o bloco estiver vazio, truncado ou declarar um tamanho impossível
+        static size_t decodedSize(std::string_view packed) {
+            size_t pos = 0, size = 0;
+            return readSize(packed, pos, size) ? size : 0;
+        }
+
+        // O tamanho declarado no início do bloco é aceitável (ver appendDecoded); confere só os primeiros bytes
+        static bool hasValidSize(std::string_view packed) {
+            size_t pos = 0, size = 0;
+            return readSize(packed, pos, size);
+        }
+
+        /* Acrescenta o texto decodificado ao fim de "out". Blocos corrompidos (referências antes do início,
+        trechos além do fim) param a decodificação no ponto do erro e retornam false, sem ler nem escrever
+        fora dos limites. O tamanho declarado no início só é aceito até MAX_DECODED e MAX_EXPANSION vezes o
+        tamanho do bloco, então um bloco adulterado não faz "out" crescer sem limite. */
+        static bool appendDecoded(std::string &out, std::string_view packed) {
+            size_t pos = 0, size = 0;
+            if (!readSize(packed, pos, size))
+                return false;
+            size_t base = out.size();
+            // A folga no fim deixa os trechos curtos serem copiados em blocos fixos de WILD_COPY bytes, sem laços
+            // nem chamadas: o que passa do trecho é sobrescrito pelo próximo ou cortado no resize final
+            out.resize(base + size + WILD_COPY);
+            char *start = out.data() + base;
+            char *dst = start;
+            char *const end = start + size;
+            const uint8_t *p = reinterpret_cast<const uint8_t *>(packed.data()) + pos;
+            const uint8_t *const pend = reinterpret_cast<const uint8_t *>(packed.data()) + packed.size();
+            bool ok = true;
+            while (p < pend) {
+                uint8_t token = *p++;
+                size_t literals = token >> 4;
+                if (literals == 15 && !addLength(p, pend, literals)) {
+                    ok = false;
+                    break;
+                }
+                if (literals > static_cast<size_t>(pend - p) || literals > static_cast<size_t>(end - dst)) {
+                    ok = false;
+                    break;
+                }
+                if (literals <= WILD_COPY && static_cast<size_t>(pend - p) >= WILD_COPY)
+                    std::memcpy(dst, p, WILD_COPY);
+                else
+                    std::memcpy(dst, p, literals);
+                p += literals;
+                dst += literals;
+                if (p == pend)
+                    break; // Última sequência: só literais
+
+                size_t length = (token & 15u) + MIN_MATCH;
+                if (pend - p < 2) {
+                    ok = false;
+                    break;
+                }
+                size_t distance = p[0] | static_cast<size_t>(p[1]) << 8;
+                p += 2;
+                if ((token & 15u) == 15 && !addLength(p, pend, length)) {
+                    ok = false;
+                    break;
+                }
+                if (distance == 0 || distance > static_cast<size_t>(dst - start) || length > static_cast<size_t>(end - dst)) {
+                    ok = false;
+                    break;
+                }
+                const char *src = dst - distance;
+                char *fim = dst + length;
+                if (distance >= WILD_COPY) {
+                    // Blocos que não se sobrepõem; o último pode passar do fim do trecho, até a folga
+                    do {
+                        std::memcpy(dst, src, WILD_COPY);
+                        dst += WILD_COPY;
+                        src += WILD_COPY;
+                    } while (dst < fim);
+                } else if (distance == 1) {
+                    std::memset(dst, *src, length);
+                } else {
+                    // Referência que se sobrepõe ao trecho: o que já foi copiado repete o padrão, então cada
+                    // cópia pode ter o dobro do tamanho da anterior sem se sobrepor à origem
+                    size_t span = distance;
+                    while (span < static_cast<size_t>(fim - dst)) {
+                        std::memcpy(dst, src, span);
+                        dst += span;
+                        span *= 2;
+                    }
+                    std::memcpy(dst, src, static_cast<size_t>(fim - dst));
+                }
+                dst = fim;
+            }
+            if (dst != end)
+                ok = false;
+            out.resize(static_cast<size_t>(dst - out.data()));
+            return ok;
+        }
+
+        static std::string decode(std::string_view packed) {
+            std::string out;
+            appendDecoded(out, packed);
+            return out;
+        }
+
+    private:
+        static constexpr uint32_t hash(const char *p) {
+            uint32_t v = static_cast<uint8_t>(p[0]) | static_cast<uint32_t>(static_cast<uint8_t>(p[1])) << 8 |
+                         static_cast<uint32_t>(static_cast<uint8_t>(p[2])) << 16 | static_cast<uint32_t>(static_cast<uint8_t>(p[3])) << 24;
+            return (v * 2654435761u) >> 20;
+        }
+
+        static constexpr void insert(std::vector<int32_t> &head, std::vector<int32_t> &prev, std::string_view text, size_t i) {
+            if (i + MIN_MATCH > text.size())
+                return;
+            uint32_t h = hash(text.data() + i);
+            prev[i] = head[h];
+            head[h] = static_cast<int32_t>(i);
+        }
+
+        // Referência mais longa para a posição i entre as já inseridas (até 64 candidatas da cadeia)
+        static constexpr size_t longestMatch(std::string_view text, const std::vector<int32_t> &head, const std::vector<int32_t> &prev,
+                                             size_t i, size_t &distance) {
+            size_t best = 0;
+            if (i + MIN_MATCH > text.size())
+                return 0;
+            const char *p = text.data();
+            const size_t n = text.size();
+            int depth = 0;
+            for (int32_t j = head[hash(p + i)]; j >= 0 && i - j <= WINDOW && depth < 64; j = prev[j], depth++) {
+                // Já achou a mais longa possível; e uma candidata só pode superar a melhor se o byte seguinte a ela conferir
+                if (i + best >= n)
+                    break;
+                if (static_cast<size_t>(j) >= i || p[j + best] != p[i + best])
+                    continue;
+                size_t length = 0;
+                while (i + length < n && p[j + length] == p[i + length])
+                    length++;
+                if (length > best) {
+                    best = length;
+                    distance = i - j;
+                }
+            }
+            return best;
+        }
+
+        static constexpr void putSequence(std::string &out, std::string_view literals, size_t length, size_t distance) {
+            size_t m = length >= MIN_MATCH ? length - MIN_MATCH : 0;
+            out.push_back(static_cast<char>(std::min<size_t>(literals.size(), 15) << 4 | std::min<size_t>(m, 15)));
+            if (literals.size() >= 15)
+                putLength(out, literals.size() - 15);
+            out.append(literals);
+            if (length < MIN_MATCH)
+                return;
+            out.push_back(static_cast<char>(distance & 0xFF));
+            out.push_back(static_cast<char>(distance >> 8));
+            if (m >= 15)
+                putLength(out, m - 15);
+        }
+
+        static constexpr void putLength(std::string &out, size_t extra) {
+            for (; extra >= 255; extra -= 255)
+                out.push_back(static_cast<char>(255));
+            out.push_back(static_cast<char>(extra));
+        }
+
+        static bool addLength(const uint8_t *&p, const uint8_t *pend, size_t &length) {
+            uint8_t byte;
+            do {
+                if (p == pend)
+                    return false;
+                byte = *p++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        }
+
+        static constexpr void putSize(std::string &out, size_t size) {
+            do {
+                uint8_t byte = size & 0x7F;
+                size >>= 7;
+                out.push_back(static_cast<char>(byte | (size ? 0x80 : 0)));
+            } while (size);
+        }
+
+        static bool readSize(std::string_view packed, size_t &pos, size_t &size) {
+            size = 0;
+            for (int shift = 0; pos < packed.size() && shift < 28; shift += 7) {
+                uint8_t byte = static_cast<uint8_t>(packed[pos++]);
+                size |= static_cast<size_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80))
+                    return size <= MAX_DECODED && size <= MAX_EXPANSION * packed.size();
+            }
+            return false;
+        }
+};
@@ -0,0 +1,200 @@
+#pragma once
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <istream>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+CanalEntrada
+Função: Ponto de espera de uma sessão por entrada do jogador. Um fluxo escrito como corrotina faz "co_await entrada.linha()" e fica suspenso, sem bloquear a thread, até quem conduz a sessão (terminal, rede, script) chamar fornecer() com o texto digitado.
+*/
+class CanalEntrada {
+    public:
+        struct Aguardar {
+            CanalEntrada &canal;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> quem) noexcept { canal.pendente = quem; }
+            std::string await_resume() { return std::move(canal.valor); }
+        };
+
+        // Suspende o fluxo até a próxima entrada
+        Aguardar linha() { return Aguardar{*this}; }
+
+        bool aguardando() const { return static_cast<bool>(pendente); }
+
+        // Entrega a entrada e continua o fluxo até a próxima espera (ou até ele terminar)
+        void fornecer(std::string texto) {
+            valor = std::move(texto);
+            std::coroutine_handle<> quem = pendente;
+            if (!quem)
+                return;
+            pendente = nullptr;
+            quem.resume();
+        }
+
+    private:
+        std::coroutine_handle<> pendente;
+        std::string valor;
+};
+
+template <class T>
+struct ResultadoTarefa {
+    std::optional<T> valor;
+    void return_value(T v) { valor = std::move(v); }
+    T obter() { return std::move(*valor); }
+};
+
+template <>
+struct ResultadoTarefa<void> {
+    void return_void() {}
+    void obter() {}
+};
+
+/*
+Tarefa
+Função: Corrotina preguiçosa que pode esperar outras Tarefas (co_await) e devolver um valor. Quando uma sub-tarefa termina, a que a esperava continua diretamente (transferência simétrica), então um fluxo pode ser dividido em funções sem bloquear em nenhuma delas.
+Os quadros das corrotinas são contados em bytesEmUso(), para medir a memória por sessão.
+*/
+template <class T = void>
+class Tarefa {
+    public:
+        struct promise_type : ResultadoTarefa<T> {
+            std::coroutine_handle<> continuacao;
+
+            Tarefa get_return_object() { return Tarefa(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+
+            struct Final {
+                bool await_ready() noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> quem) noexcept {
+                    std::coroutine_handle<> c = quem.promise().continuacao;
+                    return c ? c : std::noop_coroutine();
+                }
+                void await_resume() noexcept {}
+            };
+            Final final_suspend() noexcept { return {}; }
+            void unhandled_exception() { std::terminate(); }
+
+            static void *operator new(size_t tamanho) {
+                contadorBytes().fetch_add(tamanho, std::memory_order_relaxed);
+                return ::operator new(tamanho);
+            }
+            static void operator delete(void *p, size_t tamanho) {
+                contadorBytes().fetch_sub(tamanho, std::memory_order_relaxed);
+                ::operator delete(p);
+            }
+        };
+
+        Tarefa() {}
+        Tarefa(Tarefa &&outra) noexcept : handle(std::exchange(outra.handle, nullptr)) {}
+        Tarefa &operator=(Tarefa &&outra) noexcept {
+            if (this != &outra) {
+                if (handle)
+                    handle.destroy();
+                handle = std::exchange(outra.handle, nullptr);
+            }
+            return *this;
+        }
+        ~Tarefa() {
+            if (handle)
+                handle.destroy();
+        }
+
+        // Esperar uma sub-tarefa: ela começa agora e devolve o controle a quem esperava ao terminar
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> quem) noexcept {
+            handle.promise().continuacao = quem;
+            return handle;
+        }
+        T await_resume() { return handle.promise().obter(); }
+
+        // Para quem conduz a tarefa de fora de uma corrotina
+        void iniciar() { handle.resume(); }
+        bool concluida() const { return !handle || handle.done(); }
+        T resultado() { return handle.promise().obter(); }
+
+        // Memória ocupada por todas as corrotinas vivas deste tipo
+        static size_t bytesEmUso() { return contadorBytes().load(std::memory_order_relaxed); }
+
+    private:
+        explicit Tarefa(std::coroutine_handle<promise_type> h) : handle(h) {}
+
+        static std::atomic<size_t> &contadorBytes() {
+            static std::atomic<size_t> bytes(0);
+            return bytes;
+        }
+
+        std::coroutine_handle<promise_type> handle;
+};
+
+// Conduz um fluxo lendo cada entrada de "in" (uma palavra por vez, como "cin >>"). No fim da entrada
+// o fluxo recebe texto vazio, que os fluxos tratam como uma opção inválida.
+template <class T>
+T executarBloqueante(Tarefa<T> &fluxo, CanalEntrada &entrada, std::istream &in) {
+    fluxo.iniciar();
+    while (!fluxo.concluida()) {
+        std::string palavra;
+        if (!(in >> palavra))
+            palavra.clear();
+        entrada.fornecer(std::move(palavra));
+    }
+    return fluxo.resultado();
+}
+
+/*
+AgendadorSessoes
+Função: Mantém muitas sessões, cada uma com seu fluxo em corrotina, sua entrada e sua saída acumulada, em uma única thread. Quem recebe entradas (rede, scripts, testes) as entrega com entregar() e recolhe a saída produzida; nenhuma sessão bloqueia as outras.
+*/
+class AgendadorSessoes {
+    public:
+        struct Sessao {
+            Tarefa<> fluxo;
+            CanalEntrada entrada;
+            std::string saida;
+        };
+
+        // Abre uma sessão; fabrica(entrada, saida) cria o fluxo dela, que roda até a primeira espera
+        template <class Fabrica>
+        size_t abrir(Fabrica &&fabrica) {
+            size_t id = sessoes.size();
+            if (!livres.empty()) {
+                id = livres.back();
+                livres.pop_back();
+            } else {
+                sessoes.emplace_back();
+            }
+            sessoes[id].reset(new Sessao());
+            Sessao &s = *sessoes[id];
+            s.fluxo = fabrica(s.entrada, s.saida);
+            s.fluxo.iniciar();
+            return id;
+        }
+
+        // Entrega uma entrada à sessão; retorna false se ela não estiver esperando
+        bool entregar(size_t id, std::string texto) {
+            Sessao &s = *sessoes[id];
+            if (!s.entrada.aguardando())
+                return false;
+            s.entrada.fornecer(std::move(texto));
+            return true;
+        }
+
+        bool concluida(size_t id) const { return sessoes[id]->fluxo.concluida(); }
+        std::string &saida(size_t id) { return sessoes[id]->saida; }
+
+        void fechar(size_t id) {
+            sessoes[id].reset();
+            livres.push_back(id);
+        }
+
+    private:
+        std::vector<std::unique_ptr<Sessao>> sessoes;
+        std::vector<size_t> livres;
+};
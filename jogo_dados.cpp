@@ -0,0 +1,126 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+// Define dice constants
+
+#define coin 2
+#define d4 4
+#define d6 6
+#define d8 8
+#define d10 10
+#define d12 12
+#define d20 20
+#define d100 100
+
+/*
+Dados
+Função: Gerador de rolagens de dados com estado próprio por sessão. Usa o SplitMix64 (estado de 64 bits avançado por uma constante fixa), então a mesma semente sempre produz a mesma sequência e uma partida pode ser repetida.
+As rolagens limitadas (coin, d4 ... d100) usam a multiplicação de Lemire com rejeição, sem o viés do "rand() % n".
+rolarLote preenche um buffer inteiro em um laço sem desvios que o compilador consegue vetorizar e produz exatamente a mesma sequência que chamadas sucessivas de rolar.
+*/
+class Dados {
+    public:
+        static constexpr uint64_t GAMMA = 0x9E3779B97F4A7C15ull;
+
+        Dados() { semear(sementeAleatoria()); }
+        explicit Dados(uint64_t semente) { semear(semente); }
+
+        // Reinicia a sequência a partir da semente informada
+        void semear(uint64_t s) {
+            semente = s;
+            estado = s;
+        }
+        uint64_t getSemente() const { return semente; }
+
+        // Estado interno completo, usado para salvar e restaurar a posição na sequência
+        uint64_t getEstado() const { return estado; }
+        void setEstado(uint64_t e) { estado = e; }
+
+        // Próximo valor de 64 bits da sequência
+        uint64_t proximo() {
+            estado += GAMMA;
+            return misturar(estado);
+        }
+
+        // Rola um dado de "faces" lados (1..faces); faces menores que 1 retornam 0
+        int rolar(int faces) {
+            if (faces < 1)
+                return 0;
+            uint32_t limite = (0u - static_cast<uint32_t>(faces)) % static_cast<uint32_t>(faces);
+            while (true) {
+                uint64_t m = (proximo() >> 32) * static_cast<uint64_t>(faces);
+                if (static_cast<uint32_t>(m) >= limite)
+                    return static_cast<int>(m >> 32) + 1;
+            }
+        }
+
+        // Preenche "saida" com n rolagens de um dado de "faces" lados.
+        // A primeira passada é sem desvios; se alguma amostra cair na faixa de rejeição
+        // (probabilidade menor que faces/2^32), a sequência é refeita a partir dela pelo caminho escalar.
+        void rolarLote(int faces, int *saida, size_t n) {
+            if (faces < 1) {
+                for (size_t i = 0; i < n; i++)
+                    saida[i] = 0;
+                return;
+            }
+            const uint32_t f = static_cast<uint32_t>(faces);
+            const uint32_t limite = (0u - f) % f;
+            const uint64_t base = estado;
+            uint32_t rejeitadas = 0;
+            for (size_t i = 0; i < n; i++) {
+                uint64_t m = (misturar(base + (i + 1) * GAMMA) >> 32) * f;
+                saida[i] = static_cast<int>(m >> 32) + 1;
+                rejeitadas |= static_cast<uint32_t>(static_cast<uint32_t>(m) < limite);
+            }
+            if (!rejeitadas) {
+                estado = base + n * GAMMA;
+                return;
+            }
+            size_t i = 0;
+            while (i < n) {
+                uint64_t m = (misturar(base + (i + 1) * GAMMA) >> 32) * f;
+                if (static_cast<uint32_t>(m) < limite)
+                    break;
+                i++;
+            }
+            estado = base + i * GAMMA;
+            for (; i < n; i++)
+                saida[i] = rolar(faces);
+        }
+
+        // Semente de um fluxo independente derivado de (semente, fluxo), para dividir
+        // o trabalho entre threads sem que as sequências se sobreponham
+        static uint64_t derivar(uint64_t semente, uint64_t fluxo) {
+            return misturar(semente ^ misturar((fluxo + 1) * GAMMA));
+        }
+
+        // Semente não determinística, para sessões que não precisam ser repetidas
+        static uint64_t sementeAleatoria() {
+            std::random_device rd;
+            return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+        }
+
+    private:
+        static uint64_t misturar(uint64_t z) {
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        uint64_t semente;
+        uint64_t estado;
+};
+
+// Gerador compartilhado pelas chamadas de roll_dice que não têm uma sessão própria
+inline Dados &dados_padrao() {
+    static Dados dados;
+    return dados;
+}
+
+// Function to roll a dice
+inline int roll_dice(int dice_num)
+{
+    return dados_padrao().rolar(dice_num);
+}
@@ -0,0 +1,454 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+
+/*
+WorldState
+Função: Estado do mundo de uma sessão que as condições e efeitos das escolhas consultam e alteram: 64 marcadores (bits) e alguns atributos numéricos, em 16 bytes sem alocação.
+Os marcadores guardam decisões anteriores (ex.: a classe escolhida) e recebem nomes no texto da história; o compilador numera os nomes na ordem em que aparecem.
+*/
+constexpr int WORLD_FLAGS = 64;
+constexpr int WORLD_STATS = 4;
+constexpr std::string_view WORLD_STAT_NAMES[WORLD_STATS] = {"vida", "forca", "ouro", "pontos"};
+enum WorldStat { STAT_VIDA, STAT_FORCA, STAT_OURO, STAT_PONTOS };
+
+struct WorldState {
+    uint64_t flags = 0;
+    int16_t stats[WORLD_STATS] = {100, 100, 0, 0}; // vida e forca vão de 0 a 100
+
+    bool hasFlag(int index) const { return (flags >> index) & 1u; }
+    void setFlag(int index, bool value) {
+        uint64_t bit = uint64_t(1) << index;
+        flags = value ? (flags | bit) : (flags & ~bit);
+    }
+};
+
+/*
+Bytecode de decisões
+Função: Condições e efeitos das escolhas são compilados (na carga da história ou durante a compilação do programa) para uma sequência curta de bytes executada sobre o WorldState, sem alocações e sem interpretar texto durante o jogo.
+Condições usam uma pilha de inteiros: PushFlag/PushStat/PushConst empilham e os operadores combinam o topo. Efeitos são instruções diretas. Todo programa termina em End.
+
+    Condição: forca >= 50 e (mago ou nao cavaleiro)
+    Efeito:   mago, ouro += 10, nao cavaleiro
+*/
+enum class DecisionOp : uint8_t {
+    End,
+    PushFlag,  // índice
+    PushStat,  // índice
+    PushConst, // int16 little-endian
+    Not, And, Or,
+    Eq, Ne, Lt, Le, Gt, Ge,
+    SetFlag,   // índice
+    ClearFlag, // índice
+    AddStat,   // índice, int16
+    SetStat,   // índice, int16
+};
+
+constexpr int DECISION_MAX_CODE = 64;  // Bytes por programa
+constexpr int DECISION_MAX_STACK = 8;  // Profundidade da pilha das condições
+constexpr uint32_t DECISION_NO_CODE = 0xFFFFFFFFu;
+
+// Nomes dos marcadores de uma história, na ordem em que o compilador os encontrou
+struct DecisionSymbols {
+    std::string_view flags[WORLD_FLAGS] = {};
+    int flagCount = 0;
+
+    // Índice do marcador, criando-o se ainda não existir; -1 se já houver WORLD_FLAGS marcadores
+    constexpr int flag(std::string_view name) {
+        for (int i = 0; i < flagCount; i++)
+            if (flags[i] == name)
+                return i;
+        if (flagCount == WORLD_FLAGS)
+            return -1;
+        flags[flagCount] = name;
+        return flagCount++;
+    }
+};
+
+struct DecisionCode {
+    uint8_t bytes[DECISION_MAX_CODE] = {};
+    int size = 0;
+    const char *error = nullptr; // Motivo da falha; nullptr se compilou
+
+    constexpr bool ok() const { return error == nullptr; }
+};
+
+/*
+DecisionCompiler
+Função: Converte o texto de uma condição ou de uma lista de efeitos em bytecode. É todo constexpr, então as tabelas de jogo_historia_fixa.cpp são compiladas (e conferidas) junto com o programa.
+*/
+class DecisionCompiler {
+    public:
+        static constexpr DecisionCode compileCondition(std::string_view source, DecisionSymbols &symbols) {
+            DecisionCompiler c(source, symbols);
+            c.next();
+            c.parseOr();
+            if (c.kind != End)
+                c.fail("texto inesperado no fim da condição");
+            c.emit(DecisionOp::End);
+            return c.code;
+        }
+
+        static constexpr DecisionCode compileEffect(std::string_view source, DecisionSymbols &symbols) {
+            DecisionCompiler c(source, symbols);
+            c.next();
+            while (c.code.ok()) {
+                c.parseEffect();
+                if (c.kind == End)
+                    break;
+                if (!c.isOp(","))
+                    c.fail("esperava ',' entre os efeitos");
+                c.next();
+            }
+            c.emit(DecisionOp::End);
+            return c.code;
+        }
+
+    private:
+        enum Kind { End, Word, Number, Symbol };
+
+        constexpr DecisionCompiler(std::string_view source, DecisionSymbols &symbols) : source(source), symbols(symbols) {}
+
+        constexpr void fail(const char *motivo) {
+            if (code.ok())
+                code.error = motivo;
+            kind = End;
+        }
+
+        constexpr void emit(DecisionOp op) { emitByte(static_cast<uint8_t>(op)); }
+        constexpr void emitByte(uint8_t b) {
+            if (code.size == DECISION_MAX_CODE) {
+                fail("expressão longa demais");
+                return;
+            }
+            code.bytes[code.size++] = b;
+        }
+        constexpr void emitInt16(int v) {
+            emitByte(static_cast<uint8_t>(v & 0xFF));
+            emitByte(static_cast<uint8_t>((v >> 8) & 0xFF));
+        }
+
+        constexpr void push() {
+            if (++depth > DECISION_MAX_STACK)
+                fail("condição aninhada demais");
+        }
+
+        static constexpr bool isWordChar(char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' ||
+                   static_cast<unsigned char>(c) >= 0x80;
+        }
+
+        // Lê o próximo símbolo de "source"
+        constexpr void next() {
+            if (!code.ok())
+                return;
+            while (pos < source.size() && (source[pos] == ' ' || source[pos] == '\t'))
+                pos++;
+            if (pos == source.size()) {
+                kind = End;
+                return;
+            }
+            size_t start = pos;
+            char c = source[pos];
+            if ((c >= '0' && c <= '9') || (c == '-' && pos + 1 < source.size() && source[pos + 1] >= '0' && source[pos + 1] <= '9')) {
+                bool negative = c == '-';
+                if (negative)
+                    pos++;
+                int v = 0;
+                while (pos < source.size() && source[pos] >= '0' && source[pos] <= '9') {
+                    v = v * 10 + (source[pos++] - '0');
+                    if (v > 32767) {
+                        fail("número fora do intervalo de -32767 a 32767");
+                        return;
+                    }
+                }
+                kind = Number;
+                value = negative ? -v : v;
+            } else if (isWordChar(c)) {
+                while (pos < source.size() && isWordChar(source[pos]))
+                    pos++;
+                kind = Word;
+            } else {
+                pos++;
+                if (pos < source.size() && source[pos] == '=' && (c == '=' || c == '!' || c == '<' || c == '>' || c == '+' || c == '-'))
+                    pos++;
+                kind = Symbol;
+            }
+            token = source.substr(start, pos - start);
+        }
+
+        constexpr bool isOp(std::string_view op) const { return kind == Symbol && token == op; }
+        constexpr bool isWord(std::string_view w) const { return kind == Word && token == w; }
+        constexpr bool isNot() const { return isWord("nao") || isWord("não") || isOp("!"); }
+
+        static constexpr int statIndex(std::string_view name) {
+            for (int i = 0; i < WORLD_STATS; i++)
+                if (WORLD_STAT_NAMES[i] == name)
+                    return i;
+            return -1;
+        }
+
+        constexpr int flagIndex(std::string_view name) {
+            if (name == "e" || name == "ou" || name == "nao" || name == "não" || statIndex(name) >= 0) {
+                fail("nome de marcador reservado");
+                return 0;
+            }
+            int index = symbols.flag(name);
+            if (index < 0)
+                fail("a história usa mais de 64 marcadores");
+            return index;
+        }
+
+        constexpr void parseOr() {
+            parseAnd();
+            while (isWord("ou")) {
+                next();
+                parseAnd();
+                emit(DecisionOp::Or);
+                depth--;
+            }
+        }
+
+        constexpr void parseAnd() {
+            parseUnary();
+            while (isWord("e")) {
+                next();
+                parseUnary();
+                emit(DecisionOp::And);
+                depth--;
+            }
+        }
+
+        constexpr void parseUnary() {
+            if (isNot()) {
+                next();
+                parseUnary();
+                emit(DecisionOp::Not);
+                return;
+            }
+            if (isOp("(")) {
+                next();
+                parseOr();
+                if (!isOp(")"))
+                    fail("esperava ')'");
+                next();
+                return;
+            }
+            if (kind != Word) {
+                fail("esperava um marcador ou um atributo");
+                return;
+            }
+            int stat = statIndex(token);
+            if (stat < 0) {
+                emit(DecisionOp::PushFlag);
+                emitByte(static_cast<uint8_t>(flagIndex(token)));
+                push();
+                next();
+                return;
+            }
+            next();
+            DecisionOp op = DecisionOp::Eq;
+            if (isOp("=="))      op = DecisionOp::Eq;
+            else if (isOp("!=")) op = DecisionOp::Ne;
+            else if (isOp("<"))  op = DecisionOp::Lt;
+            else if (isOp("<=")) op = DecisionOp::Le;
+            else if (isOp(">"))  op = DecisionOp::Gt;
+            else if (isOp(">=")) op = DecisionOp::Ge;
+            else {
+                fail("esperava uma comparação depois do atributo");
+                return;
+            }
+            next();
+            if (kind != Number) {
+                fail("esperava um número na comparação");
+                return;
+            }
+            emit(DecisionOp::PushStat);
+            emitByte(static_cast<uint8_t>(stat));
+            push();
+            emit(DecisionOp::PushConst);
+            emitInt16(value);
+            push();
+            emit(op);
+            depth--;
+            next();
+        }
+
+        constexpr void parseEffect() {
+            bool clear = isNot();
+            if (clear)
+                next();
+            if (kind != Word) {
+                fail("esperava um marcador ou um atributo");
+                return;
+            }
+            int stat = statIndex(token);
+            if (stat < 0) {
+                emit(clear ? DecisionOp::ClearFlag : DecisionOp::SetFlag);
+                emitByte(static_cast<uint8_t>(flagIndex(token)));
+                next();
+                return;
+            }
+            if (clear) {
+                fail("'nao' só se aplica a marcadores");
+                return;
+            }
+            next();
+            int sign = isOp("+=") ? 1 : isOp("-=") ? -1 : 0;
+            if (sign == 0 && !isOp("=")) {
+                fail("esperava '=', '+=' ou '-=' depois do atributo");
+                return;
+            }
+            next();
+            if (kind != Number) {
+                fail("esperava um número no efeito");
+                return;
+            }
+            emit(sign == 0 ? DecisionOp::SetStat : DecisionOp::AddStat);
+            emitByte(static_cast<uint8_t>(stat));
+            emitInt16(sign == 0 ? value : sign * value);
+            next();
+        }
+
+        std::string_view source;
+        DecisionSymbols &symbols;
+        size_t pos = 0;
+        Kind kind = End;
+        std::string_view token;
+        int value = 0;
+        int depth = 0;
+        DecisionCode code;
+};
+
+inline int16_t readDecisionInt16(const uint8_t *p) {
+    return static_cast<int16_t>(static_cast<uint16_t>(p[0] | (p[1] << 8)));
+}
+
+/* Confere um programa vindo de fora do processo (ex.: do pool de um historia.bin) antes que ele seja executado:
+só instruções de condição ou só de efeito (conforme "condition"), índices de marcadores e atributos dentro dos
+limites, pilha sem esvaziar nem passar de DECISION_MAX_STACK, e um End nos primeiros "available" bytes (no
+máximo DECISION_MAX_CODE). Uma condição termina com exatamente um valor na pilha. */
+inline bool verifyDecisionCode(const uint8_t *code, size_t available, bool condition) {
+    size_t limit = available < DECISION_MAX_CODE ? available : DECISION_MAX_CODE;
+    size_t pc = 0;
+    int depth = 0;
+    while (pc < limit) {
+        DecisionOp op = static_cast<DecisionOp>(code[pc++]);
+        size_t operands = 0;
+        int maxIndex = 0; // Limite do primeiro operando, quando ele é um índice
+        switch (op) {
+            case DecisionOp::End:
+                return !condition || depth == 1;
+            case DecisionOp::PushFlag:
+            case DecisionOp::PushStat:
+            case DecisionOp::PushConst:
+                if (!condition || ++depth > DECISION_MAX_STACK)
+                    return false;
+                operands = op == DecisionOp::PushConst ? 2 : 1;
+                maxIndex = op == DecisionOp::PushFlag ? WORLD_FLAGS : op == DecisionOp::PushStat ? WORLD_STATS : 0;
+                break;
+            case DecisionOp::Not:
+                if (!condition || depth < 1)
+                    return false;
+                break;
+            case DecisionOp::And: case DecisionOp::Or:
+            case DecisionOp::Eq: case DecisionOp::Ne: case DecisionOp::Lt:
+            case DecisionOp::Le: case DecisionOp::Gt: case DecisionOp::Ge:
+                if (!condition || depth < 2)
+                    return false;
+                depth--;
+                break;
+            case DecisionOp::SetFlag:
+            case DecisionOp::ClearFlag:
+                if (condition)
+                    return false;
+                operands = 1;
+                maxIndex = WORLD_FLAGS;
+                break;
+            case DecisionOp::AddStat:
+            case DecisionOp::SetStat:
+                if (condition)
+                    return false;
+                operands = 3;
+                maxIndex = WORLD_STATS;
+                break;
+            default:
+                return false;
+        }
+        if (operands > limit - pc || (maxIndex > 0 && code[pc] >= maxIndex))
+            return false;
+        pc += operands;
+    }
+    return false;
+}
+
+// Executa uma condição já conferida (compilada pelo DecisionCompiler ou aceita por verifyDecisionCode)
+inline bool evaluateCondition(const uint8_t *code, const WorldState &world) {
+    int32_t stack[DECISION_MAX_STACK];
+    int sp = 0;
+    while (true) {
+        DecisionOp op = static_cast<DecisionOp>(*code++);
+        switch (op) {
+            case DecisionOp::End:
+                return sp > 0 && stack[sp - 1] != 0;
+            case DecisionOp::PushFlag:
+                stack[sp++] = world.hasFlag(*code++);
+                break;
+            case DecisionOp::PushStat:
+                stack[sp++] = world.stats[*code++];
+                break;
+            case DecisionOp::PushConst:
+                stack[sp++] = readDecisionInt16(code);
+                code += 2;
+                break;
+            case DecisionOp::Not:
+                stack[sp - 1] = !stack[sp - 1];
+                break;
+            case DecisionOp::And: case DecisionOp::Or:
+            case DecisionOp::Eq: case DecisionOp::Ne: case DecisionOp::Lt:
+            case DecisionOp::Le: case DecisionOp::Gt: case DecisionOp::Ge: {
+                int32_t b = stack[--sp];
+                int32_t &a = stack[sp - 1];
+                switch (op) {
+                    case DecisionOp::And: a = a && b; break;
+                    case DecisionOp::Or:  a = a || b; break;
+                    case DecisionOp::Eq:  a = a == b; break;
+                    case DecisionOp::Ne:  a = a != b; break;
+                    case DecisionOp::Lt:  a = a < b; break;
+                    case DecisionOp::Le:  a = a <= b; break;
+                    case DecisionOp::Gt:  a = a > b; break;
+                    default:              a = a >= b; break;
+                }
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+}
+
+// Aplica uma lista de efeitos já conferida; vida e forca ficam entre 0 e 100
+inline void applyEffect(const uint8_t *code, WorldState &world) {
+    while (true) {
+        switch (static_cast<DecisionOp>(*code++)) {
+            case DecisionOp::SetFlag:
+                world.setFlag(*code++, true);
+                break;
+            case DecisionOp::ClearFlag:
+                world.setFlag(*code++, false);
+                break;
+            case DecisionOp::AddStat:
+            case DecisionOp::SetStat: {
+                bool add = static_cast<DecisionOp>(code[-1]) == DecisionOp::AddStat;
+                int stat = *code++;
+                int32_t v = readDecisionInt16(code) + (add ? world.stats[stat] : 0);
+                code += 2;
+                int32_t lo = stat <= STAT_FORCA ? 0 : -32767, hi = stat <= STAT_FORCA ? 100 : 32767;
+                world.stats[stat] = static_cast<int16_t>(v < lo ? lo : v > hi ? hi : v);
+                break;
+            }
+            default:
+                return;
+        }
+    }
+}
@@ -0,0 +1,236 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <istream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*
+Dialogos
+Função: Motor de diálogos guiado por tabelas. Cada personagem (ou NPC) tem uma tabela "fala => resposta" carregada de dados (DIALOGOS_PADRAO ou um dialogos.txt, no formato abaixo); as falas são internadas uma única vez e passam a ser ids inteiros, e a resposta de uma tabela a uma fala é uma busca em uma tabela de hash única, indexada pelo par (tabela, fala).
+Depois de carregado, o motor só é lido: uma conversa inteira roda sobre ids, sem comparar textos e sem alocar, e milhares de NPCs com tabelas próprias dividem a mesma tabela de hash.
+Formato:
+
+    # comentário
+    [Cavaleiro]
+    Olá! => Como vai, nobre amigo?
+    Tchau! => Até logo!
+
+Falas sem resposta na tabela recebem NAO_SEI, que encerra a conversa.
+*/
+class Dialogos {
+    public:
+        static constexpr uint32_t SEM_FALA = 0xFFFFFFFFu;
+        static constexpr std::string_view NAO_SEI = "Não sei dizer.";
+        static constexpr int LIMITE_TURNOS = 64; // Tabelas com ciclos não prendem a conversa
+
+        Dialogos() { naoSei = internar(NAO_SEI); }
+        Dialogos(const Dialogos &) = delete;
+        Dialogos &operator=(const Dialogos &) = delete;
+
+        // Id da fala, criando-o se ela ainda não existir
+        uint32_t internar(std::string_view texto) {
+            auto it = ids.find(texto);
+            if (it != ids.end())
+                return it->second;
+            uint32_t id = static_cast<uint32_t>(falas.size());
+            falas.emplace_back(texto);
+            ids.emplace(falas.back(), id);
+            return id;
+        }
+
+        // Id de uma fala conhecida; SEM_FALA se ninguém a usa
+        uint32_t procurar(std::string_view texto) const {
+            auto it = ids.find(texto);
+            return it != ids.end() ? it->second : SEM_FALA;
+        }
+
+        std::string_view texto(uint32_t fala) const { return fala < falas.size() ? std::string_view(falas[fala]) : std::string_view(); }
+
+        // Id da tabela "nome", criando-a se ela ainda não existir
+        uint32_t criarTabela(std::string_view nome) {
+            uint32_t id = procurarTabela(nome);
+            if (id != SEM_FALA)
+                return id;
+            nomesTabelas.emplace_back(nome);
+            id = static_cast<uint32_t>(nomesTabelas.size() - 1);
+            tabelas.emplace(nomesTabelas.back(), id);
+            return id;
+        }
+
+        uint32_t procurarTabela(std::string_view nome) const {
+            auto it = tabelas.find(nome);
+            return it != tabelas.end() ? it->second : SEM_FALA;
+        }
+
+        // Define (ou troca) a resposta da tabela à fala
+        void definir(uint32_t tabela, uint32_t fala, uint32_t resposta) {
+            if ((usadas + 1) * 2 > entradas.size())
+                crescer();
+            Entrada &e = entradas[posicao(chave(tabela, fala))];
+            if (e.chave == VAZIA)
+                usadas++;
+            e = {chave(tabela, fala), resposta};
+        }
+
+        void definir(std::string_view tabela, std::string_view fala, std::string_view resposta) {
+            definir(criarTabela(tabela), internar(fala), internar(resposta));
+        }
+
+        // Resposta da tabela à fala; NAO_SEI (getNaoSei) se a tabela não tiver uma
+        uint32_t responder(uint32_t tabela, uint32_t fala) const {
+            if (entradas.empty() || fala == SEM_FALA || tabela == SEM_FALA)
+                return naoSei;
+            const Entrada &e = entradas[posicao(chave(tabela, fala))];
+            return e.chave == VAZIA ? naoSei : e.resposta;
+        }
+
+        uint32_t getNaoSei() const { return naoSei; }
+        size_t getQuantidadeFalas() const { return falas.size(); }
+        size_t getQuantidadeTabelas() const { return nomesTabelas.size(); }
+        size_t getQuantidadeRespostas() const { return usadas; }
+
+        /* Conversa entre as tabelas "a" e "b" a partir da fala "inicio" de "a", no mesmo roteiro do
+        SerHumano::converse: "a" fala, "b" responde, "a" responde à resposta, até um dos dois não saber
+        o que dizer. visita(quem, fala) recebe cada fala dita (quem = 0 para "a", 1 para "b").
+        Retorna a quantidade de falas ditas. */
+        template <class Visita>
+        int conversar(uint32_t a, uint32_t b, uint32_t inicio, Visita &&visita) const {
+            int ditas = 0;
+            uint32_t minha = inicio;
+            for (int turno = 0; turno < LIMITE_TURNOS; turno++) {
+                visita(0, minha);
+                uint32_t resposta = responder(b, minha);
+                visita(1, resposta);
+                ditas += 2;
+                minha = responder(a, resposta);
+                if (resposta == naoSei || minha == naoSei)
+                    break;
+            }
+            return ditas;
+        }
+
+        // Lê tabelas no formato descrito acima, acrescentando às já carregadas
+        bool carregar(std::istream &in, std::string &erro) {
+            std::string linha;
+            uint32_t tabela = SEM_FALA;
+            for (int numero = 1; std::getline(in, linha); numero++) {
+                std::string_view l = aparar(linha);
+                if (l.empty() || l[0] == '#')
+                    continue;
+                if (l.front() == '[') {
+                    if (l.back() != ']' || l.size() < 3) {
+                        erro = "linha " + std::to_string(numero) + ": nome de tabela inválido";
+                        return false;
+                    }
+                    tabela = criarTabela(aparar(l.substr(1, l.size() - 2)));
+                    continue;
+                }
+                size_t seta = l.find("=>");
+                if (seta == std::string_view::npos || tabela == SEM_FALA) {
+                    erro = "linha " + std::to_string(numero) + (tabela == SEM_FALA ? ": fala fora de uma [tabela]" : ": esperado \"fala => resposta\"");
+                    return false;
+                }
+                definir(tabela, internar(aparar(l.substr(0, seta))), internar(aparar(l.substr(seta + 2))));
+            }
+            return true;
+        }
+
+        bool carregar(std::string_view texto, std::string &erro) {
+            std::istringstream in{std::string(texto)};
+            return carregar(in, erro);
+        }
+
+    private:
+        struct Entrada {
+            uint64_t chave;
+            uint32_t resposta;
+        };
+        static constexpr uint64_t VAZIA = ~0ull;
+
+        static uint64_t chave(uint32_t tabela, uint32_t fala) { return static_cast<uint64_t>(tabela) << 32 | fala; }
+
+        // Endereçamento aberto com sondagem linear; a tabela fica no máximo pela metade
+        size_t posicao(uint64_t k) const {
+            size_t mascara = entradas.size() - 1;
+            uint64_t h = k * 0x9E3779B97F4A7C15ull;
+            size_t i = static_cast<size_t>(h >> 32) & mascara;
+            while (entradas[i].chave != VAZIA && entradas[i].chave != k)
+                i = (i + 1) & mascara;
+            return i;
+        }
+
+        void crescer() {
+            std::vector<Entrada> antigas(entradas.empty() ? 16 : entradas.size() * 2, Entrada{VAZIA, 0});
+            antigas.swap(entradas);
+            for (const Entrada &e : antigas)
+                if (e.chave != VAZIA)
+                    entradas[posicao(e.chave)] = e;
+        }
+
+        static std::string_view aparar(std::string_view s) {
+            while (!s.empty() && (s.front() == ' ' || s.front() == '\t'))
+                s.remove_prefix(1);
+            while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r'))
+                s.remove_suffix(1);
+            return s;
+        }
+
+        // deque: os textos não mudam de endereço, então as chaves dos mapas continuam válidas
+        std::deque<std::string> falas;
+        std::unordered_map<std::string_view, uint32_t> ids;
+        std::deque<std::string> nomesTabelas;
+        std::unordered_map<std::string_view, uint32_t> tabelas;
+        std::vector<Entrada> entradas;
+        size_t usadas = 0;
+        uint32_t naoSei;
+};
+
+// Falas padrão dos personagens; é a única cópia delas que acompanha o jogo
+constexpr std::string_view DIALOGOS_PADRAO = R"(
+[SerHumano]
+Olá! => Tudo bem?
+Tudo bem? => Sim, e você?
+Sim, e você? => Estou ótimo!
+Até logo! => Até!
+Tchau! => Tchau!
+
+[Cavaleiro]
+Olá! => Como vai, nobre amigo?
+Tudo bem? => Sim, e como está Vossa senhoria?
+Sim, e você? => Estou passando muito bem!
+Até logo! => Até a próxima!
+Tchau! => Até logo!
+
+[Aldeao]
+Olá! => To de boa, e você?
+Tudo bem? => Não é da sua conta!
+Sim, e você? => Então, larga mão!
+Até logo! => Se cuida!
+Tchau! => Tô nem aí!
+)";
+
+// Tabelas padrão: as embutidas (DIALOGOS_PADRAO), ou as de um dialogos.txt que o jogador coloque na pasta do
+// jogo para trocá-las. Um dialogos.txt com erro é avisado no std::cerr e as embutidas são usadas no lugar dele.
+// São carregadas uma única vez por processo e compartilhadas (só leitura) por todos os personagens
+inline const Dialogos &dialogos_padrao() {
+    static Dialogos arquivo, embutidos;
+    static const Dialogos &escolhidos = [] () -> const Dialogos & {
+        std::ifstream in("dialogos.txt");
+        std::string erro;
+        if (in) {
+            if (arquivo.carregar(in, erro))
+                return arquivo;
+            std::cerr << "dialogos.txt ignorado (" << erro << "); usando os diálogos padrão\n";
+        }
+        if (!embutidos.carregar(DIALOGOS_PADRAO, erro))
+            std::cerr << "Diálogos padrão inválidos: " << erro << "\n";
+        return embutidos;
+    }();
+    return escolhidos;
+}
@@ -2,22 +2,24 @@
 #include <iostream>
 #include <cstring>
 #include <locale>
+#include <cstdlib>
+#include "jogo_dados.cpp"
+#include "jogo_corrotinas.cpp"
+#include "jogo_masmorra.cpp"
+#include "jogo_metricas.cpp"
+#include "jogo_rastreio.cpp"
+#include "jogo_replay.cpp"
+#include "jogo_ritmo.cpp"
 
-#define coin 2
-#define d4 4
-#define d6 6
-#define d8 8
-#define d10 10
-#define d12 12
-#define d20 20
-#define d100 100
 #define qtde_caminhos 15
 
 using namespace std;
 
-unsigned int roll_saver;
+// As classes deste jogo ficam em um namespace próprio para não colidir com as de jogo_personagens.cpp
+// quando os dois são usados juntos (ex.: no jogo_microbenchmarks)
+namespace encontros {
 
-int roll_dice (int dice_num);
+unsigned int roll_saver;
 
 class FormaDeVida 
 {
@@ -148,232 +150,334 @@ class Evento_Randomico
 {
 unsigned int mod_sala;
 unsigned int points;
+Masmorra masmorra;
+Sala sala = masmorra.sala(0, 0); // Sala em que o grupo está; começa na entrada da masmorra
+ReplayLog *registro = nullptr;
+ReplayCursor *repeticao = nullptr;
+Ritmo ritmo;
 
 public:
 
+    // Masmorra percorrida pelo grupo (ver Masmorra); o grupo volta para a entrada dela
+    void setMasmorra(const Masmorra &m)
+    {
+        masmorra = m;
+        sala = masmorra.sala(0, 0);
+    }
+
+    const Sala &getSala() const { return sala; }
+
+    // Relógio com que as versões bloqueantes fazem as pausas marcadas na saída (ver Ritmo); o padrão é o tempo real
+    void setRitmo(const Ritmo &r) { ritmo = r; }
+
+    // Gravação e reprodução das respostas do jogador (ver ReplayLog): com um registro, cada resposta
+    // lida é gravada; com uma repetição, as respostas vêm do registro em vez do cin
+    void gravarEm(ReplayLog *r) { registro = r; }
+    void repetirDe(ReplayCursor *r) { repeticao = r; }
+
+    // Respostas que os fluxos tratam igual viram o mesmo código: 1 a 3 (sala), 4 ("s"), 5 ("n") e 6 (qualquer outra)
+    static uint32_t codificar(const std::string &resposta)
+    {
+        if (resposta == "s" || resposta == "S")
+            return 4;
+        if (resposta == "n" || resposta == "N")
+            return 5;
+        unsigned long sala = std::strtoul(resposta.c_str(), nullptr, 10);
+        return sala >= 1 && sala <= 3 ? static_cast<uint32_t>(sala) : 6;
+    }
+
+    static const char *decodificar(uint32_t codigo)
+    {
+        static const char *respostas[] = {"", "1", "2", "3", "s", "n", ""};
+        return codigo < 7 ? respostas[codigo] : "";
+    }
+
+    // Versões bloqueantes, para o jogo de console: cada entrada é lida do cin (ou da repetição) e a saída
+    // dos fluxos é mostrada no cout antes de cada pergunta, com as pausas marcadas nela (ver Ritmo)
     unsigned int escolhe_sala()
     {
-        unsigned int choice_1;
-        cout<<"Escolha a sala entre: (1) Sala Clara || (2) Sala Meio Iluminada || (3) Sala Escura: ";
-        cin>>choice_1;
+        CanalEntrada entrada;
+        std::string saida;
+        Tarefa<unsigned int> fluxo = fluxo_escolhe_sala(entrada, saida);
+        return conduzir(fluxo, entrada, saida);
+    }
+
+    void acontecimento()
+    {
+        CanalEntrada entrada;
+        std::string saida;
+        Tarefa<> fluxo = fluxo_acontecimento(entrada, saida);
+        conduzir(fluxo, entrada, saida);
+    }
+
+    void randomiza_evento()
+    {
+        CanalEntrada entrada;
+        std::string saida;
+        Tarefa<> fluxo = fluxo_randomiza_evento(entrada, saida);
+        conduzir(fluxo, entrada, saida);
+    }
 
-        switch (choice_1)
+    template <class T>
+    T conduzir(Tarefa<T> &fluxo, CanalEntrada &entrada, std::string &saida)
+    {
+        fluxo.iniciar();
+        while (!fluxo.concluida())
         {
-        case 1:
-            mod_sala = 0;
-            points = 1;
-            break;
+            ritmo.exibir(saida);
+            saida.clear();
+            std::string resposta;
+            uint32_t codigo;
+            if (repeticao)
+            {
+                if (repeticao->next(codigo))
+                    resposta = decodificar(codigo);
+            }
+            else if (!(cin >> resposta))
+                resposta.clear();
+            if (registro)
+                registro->record(codificar(resposta));
+            entrada.fornecer(std::move(resposta));
+        }
+        ritmo.exibir(saida);
+        saida.clear();
+        return fluxo.resultado();
+    }
 
-        case 2:
-            mod_sala = 1;
-            points = 2;
-            break;
+    // Versões em corrotina: o texto vai para "saida" e, nas perguntas ao jogador, o fluxo fica suspenso
+    // em "entrada" em vez de bloquear no cin, como no Game::play; então várias salas (de vários jogadores)
+    // podem andar na mesma thread, pela rede ou sem terminal. As pausas só ficam marcadas na saída, a
+    // lógica não espera. Os TRACE_SCOPE ficam em blocos sem co_await: não medem o tempo em que o jogador
+    // pensa e não se cruzam com os de outras sessões na mesma thread
+    Tarefa<unsigned int> fluxo_escolhe_sala(CanalEntrada &entrada, std::string &saida)
+    {
+        unsigned int choice_1;
+        saida += "Escolha a sala entre: (1) Sala Clara || (2) Sala Meio Iluminada || (3) Sala Escura: ";
+        std::string texto = co_await entrada.linha();
+        {
+            TRACE_SCOPE("escolhe_sala");
+            choice_1 = static_cast<unsigned int>(std::strtoul(texto.c_str(), nullptr, 10));
 
-        case 3:
-            mod_sala = 3;
-            points = 3;
-            break;
-        
-        default:
-            roll_saver = roll_dice(d100);
-            if(roll_saver<=95)
+            // Cada porta leva a uma sala da masmorra, gerada ao entrar; a iluminação dela vem da porta
+            switch (choice_1)
             {
-                cout<<"O grupo caiu no abismo e todos pereceram! GAME OVER! \n\n";
-                points = 16;
-                return points;
+            case 1:
+            case 2:
+            case 3:
+                sala = masmorra.vizinha(sala, choice_1);
+                mod_sala = sala.modificador;
+                points = choice_1;
                 break;
+        
+            default:
+                if(!sala.passagemSecreta)
+                {
+                    saida += "O grupo caiu no abismo e todos pereceram! GAME OVER! \n\n";
+                    points = 16;
+                    co_return points;
+                    break;
+                }
+                else
+                {
+                    saida += "Uma sala secreta!\n";
+                    Ritmo::marcarPausa(saida, 500);
+                    saida += ".";
+                    Ritmo::marcarPausa(saida, 500);
+                    saida += ".";
+                    Ritmo::marcarPausa(saida, 500);
+                    saida += ".\n";
+                    Ritmo::marcarPausa(saida, 500);
+                    saida += "Mas o quê?! É a Bruxa do 71! ATACAR!";
+                    points = 16;
+                    co_return points;
+                    break;
+                }
+
             }
-            if(roll_saver>95)
+            switch (sala.entrada)
             {
-                cout<<"Uma sala secreta!\n";
-                _sleep(500);
-                cout<<".";
-                _sleep(500);
-                cout<<".";
-                _sleep(500);
-                cout<<".\n";
-                _sleep(500);
-                cout<<"Mas o quê?! É a Bruxa do 71! ATACAR!";
-                points = 16;
-                return points;
+            case 1:
+                saida += "O grupo entra na sala sem problemas. \n\n";
+                break;
+            case 2:
+                saida += "Uma armadilha no meio do caminho acerta o grupo! Todos tomam " + std::to_string(sala.danoArmadilha) + " de dano! \n\n";
+                break;
+            case 3:
+                saida += "Um caminho tranquilo, na medida do possível... \n\n";
+                break;
+            case 4:
+                saida += "Gases enfraquecedores se abatem sobre o grupo! Vocês estão fracos e causam menos " + std::to_string(sala.enfraquecimento) + " de dano de ataque! \n\n";
                 break;
-            }
-
-        }
-        switch (roll_dice(d4))
-        {
-        case 1:
-            cout<<"O grupo entra na sala sem problemas. \n\n";
-            break;
-        case 2:
-            cout<<"Uma armadilha no meio do caminho acerta o grupo! Todos tomam "<<roll_dice(d10)<<" de dano! \n\n";
-            break;
-        case 3:
-            cout<<"Um caminho tranquilo, na medida do possível... \n\n";
-            break;
-        case 4:
-            cout<<"Gases enfraquecedores se abatem sobre o grupo! Vocês estão fracos e causam menos "<<roll_dice(d8)<<" de dano de ataque! \n\n";
-            break;
 
-        default:
-            cout<<"Se vc está lendo isso a rebelião das máquinas já começou! Encontre John Connor, ele saberá o que fazer! \n\n";
-            break;
+            default:
+                saida += "Se vc está lendo isso a rebelião das máquinas já começou! Encontre John Connor, ele saberá o que fazer! \n\n";
+                break;
+            }
         }
 
-        acontecimento();
-        return points;
+        co_await fluxo_acontecimento(entrada, saida);
+        co_return points;
 
     }
 
-    void acontecimento()
+    Tarefa<> fluxo_acontecimento(CanalEntrada &entrada, std::string &saida)
     {
-        switch (roll_dice(d6))
+        bool pergunta = false;
         {
-        case 1:
-            cout<<"Os heróis encontram uma caixa, querem abrir para conferir o conteúdo? s/n: ";
-            _sleep(1);
-            randomiza_evento();
-            break;
+            TRACE_SCOPE("acontecimento");
+            switch (sala.acontecimento)
+            {
+            case 1:
+                saida += "Os heróis encontram uma caixa, querem abrir para conferir o conteúdo? s/n: ";
+                Ritmo::marcarPausa(saida, 1);
+                pergunta = true;
+                break;
 
-        case 2:
-            cout<<"Há uma mesa com itens diversos, querem mexer para conferir se há algo útil? s/n: ";
-            _sleep(1);
-            randomiza_evento();
-            break;    
+            case 2:
+                saida += "Há uma mesa com itens diversos, querem mexer para conferir se há algo útil? s/n: ";
+                Ritmo::marcarPausa(saida, 1);
+                pergunta = true;
+                break;    
         
-        case 3:
-            cout<<"Um buraco foi cavado no chão para esconder algo, querem desenterrar para ver o que é? s/n: ";
-            _sleep(1);
-            randomiza_evento();
-            break;
+            case 3:
+                saida += "Um buraco foi cavado no chão para esconder algo, querem desenterrar para ver o que é? s/n: ";
+                Ritmo::marcarPausa(saida, 1);
+                pergunta = true;
+                break;
 
-        case 4:
-            cout<<"Um baú os aguarda no fim da sala, desejam abrir? s/n: ";
-            _sleep(1);
-            randomiza_evento();
-            break;
+            case 4:
+                saida += "Um baú os aguarda no fim da sala, desejam abrir? s/n: ";
+                Ritmo::marcarPausa(saida, 1);
+                pergunta = true;
+                break;
 
-        case 5:
-            roll_saver = roll_dice(d4);
-            cout<<"Oh, não! A sala tem "<<roll_saver<<" ogro(s)! Vocês precisam lutar para sair! \n\n";
-            _sleep(1);
-            break;
+            case 5:
+                saida += "Oh, não! A sala tem " + std::to_string(sala.ogros) + " ogro(s)! Vocês precisam lutar para sair! \n\n";
+                Ritmo::marcarPausa(saida, 1);
+                break;
 
-        case 6:
-            cout<<"A sala está vazia... Sorte? Será? \n\n";
-            _sleep(1);
-            break;
+            case 6:
+                saida += "A sala está vazia... Sorte? Será? \n\n";
+                Ritmo::marcarPausa(saida, 1);
+                break;
 
-        default:
-            cout<<"Se vc está lendo isso a rebelião das máquinas já começou! Encontre John Connor, ele saberá o que fazer! \n\n";
-            break;
+            default:
+                saida += "Se vc está lendo isso a rebelião das máquinas já começou! Encontre John Connor, ele saberá o que fazer! \n\n";
+                break;
+            }
         }
+        if (pergunta)
+            co_await fluxo_randomiza_evento(entrada, saida);
     }   
-    void evento_bom()
+
+    void evento_bom(std::string &saida)
     {
-        _sleep(1);
+        Metrics::count(Counter::EventGood);
+        Ritmo::marcarPausa(saida, 1);
         switch (roll_dice(d4))
         {
         case 1:
-            _sleep(1);
+            Ritmo::marcarPausa(saida, 1);
             roll_saver = roll_dice(d6)+mod_sala;
-            cout<<"Vocês encontraram comida! Todos curam "<<roll_saver<<" de vida! \n\n";
+            saida += "Vocês encontraram comida! Todos curam " + std::to_string(roll_saver) + " de vida! \n\n";
             break;
         case 2:
-            _sleep(1);
+            Ritmo::marcarPausa(saida, 1);
             roll_saver = roll_dice(coin)+mod_sala;
-            cout<<"Vocês encontraram um tônico! Todos causam mais "<<roll_saver<<" de dano! \n\n";
+            saida += "Vocês encontraram um tônico! Todos causam mais " + std::to_string(roll_saver) + " de dano! \n\n";
             break;
 
         case 3:
-            _sleep(1);
+            Ritmo::marcarPausa(saida, 1);
             roll_saver = roll_dice(d10)+mod_sala;
-            cout<<"Vocês encontraram poções! Todos curam "<<roll_saver<<" de vida! \n\n";
+            saida += "Vocês encontraram poções! Todos curam " + std::to_string(roll_saver) + " de vida! \n\n";
             break;
 
         case 4:
-            _sleep(1);
+            Ritmo::marcarPausa(saida, 1);
             roll_saver = roll_dice(d8)+mod_sala;
-            cout<<"Vocês são envolvidos por uma magia poderosa! Todos causam mais "<<roll_saver<<" de dano! \n\n";
+            saida += "Vocês são envolvidos por uma magia poderosa! Todos causam mais " + std::to_string(roll_saver) + " de dano! \n\n";
             break;
         
         default:
-            cout<<"Se vc está lendo isso a rebelião das máquinas já começou! Encontre John Connor, ele saberá o que fazer! \n\n";
+            saida += "Se vc está lendo isso a rebelião das máquinas já começou! Encontre John Connor, ele saberá o que fazer! \n\n";
             break;
         }
     }
 
-    void evento_neutro()
+    void evento_neutro(std::string &saida)
     {
-        _sleep(1);
+        Metrics::count(Counter::EventNeutral);
+        Ritmo::marcarPausa(saida, 1);
         switch (roll_dice(d4))
         {
         case 1:
-            _sleep(1);
-            cout<<"A curiosidade matou o gato, mas não dessa vez! \n\n";
+            Ritmo::marcarPausa(saida, 1);
+            saida += "A curiosidade matou o gato, mas não dessa vez! \n\n";
             break;
         case 2:
-            _sleep(1);
-            cout<<"Não há nada aqui! \n\n";
+            Ritmo::marcarPausa(saida, 1);
+            saida += "Não há nada aqui! \n\n";
             break;
 
         case 3:
-            _sleep(1);
-            cout<<"O conteúdo já foi saqueado! \n\n";
+            Ritmo::marcarPausa(saida, 1);
+            saida += "O conteúdo já foi saqueado! \n\n";
             break;
 
         case 4:
-            _sleep(1);
-            cout<<"Está vazio! \n\n";
+            Ritmo::marcarPausa(saida, 1);
+            saida += "Está vazio! \n\n";
             break;
         
         default:
-            cout<<"Se vc está lendo isso a rebelião das máquinas já começou! Encontre John Connor, ele saberá o que fazer! \n\n";
+            saida += "Se vc está lendo isso a rebelião das máquinas já começou! Encontre John Connor, ele saberá o que fazer! \n\n";
             break;
         }
     }
 
-    void evento_ruim()
+    void evento_ruim(std::string &saida)
     {
-        _sleep(1);
+        Metrics::count(Counter::EventBad);
+        Ritmo::marcarPausa(saida, 1);
         switch (roll_dice(d4))
         {
         case 1:
-            _sleep(1);
+            Ritmo::marcarPausa(saida, 1);
             roll_saver = roll_dice(d8)+mod_sala;
-            cout<<"Um fedor enauseante toma a sala! Todos levam "<<roll_saver<<" de dano! \n\n";
+            saida += "Um fedor enauseante toma a sala! Todos levam " + std::to_string(roll_saver) + " de dano! \n\n";
             break;
         case 2:
-            _sleep(1);
+            Ritmo::marcarPausa(saida, 1);
             roll_saver = roll_dice(d6)+mod_sala;
-            cout<<"Uma armadilha bem posicionada! Todos levam "<<roll_saver<<" de dano! \n\n";
+            saida += "Uma armadilha bem posicionada! Todos levam " + std::to_string(roll_saver) + " de dano! \n\n";
             break;
 
         case 3:
-            _sleep(1);
+            Ritmo::marcarPausa(saida, 1);
             roll_saver = roll_dice(d4)+mod_sala;
-            cout<<"Uma maldição se abate sobre o grupo! Todos causam menos "<<roll_saver<<" de dano! \n\n";
+            saida += "Uma maldição se abate sobre o grupo! Todos causam menos " + std::to_string(roll_saver) + " de dano! \n\n";
             break;
 
         case 4:
-            _sleep(1);
+            Ritmo::marcarPausa(saida, 1);
             roll_saver = roll_dice(d10)+mod_sala;
-            cout<<"Vocês são envolvidos por um feitiço poderoso! Todos causam menos "<<roll_saver<<" de dano! \n\n";
+            saida += "Vocês são envolvidos por um feitiço poderoso! Todos causam menos " + std::to_string(roll_saver) + " de dano! \n\n";
             break;
         
         default:
-            cout<<"Se vc está lendo isso a rebelião das máquinas já começou! Encontre John Connor, ele saberá o que fazer! \n\n";
+            saida += "Se vc está lendo isso a rebelião das máquinas já começou! Encontre John Connor, ele saberá o que fazer! \n\n";
             break;
         }
 
     }
 
-    void randomiza_evento()
+    Tarefa<> fluxo_randomiza_evento(CanalEntrada &entrada, std::string &saida)
     {
-        std::string choice;
-        cin>>choice;
+        std::string choice = co_await entrada.linha();
+        TRACE_SCOPE("randomiza_evento");
         const char *escolha = choice.c_str();
-        _sleep(1);
+        Ritmo::marcarPausa(saida, 1);
 
             if(!strcmp("s",escolha)||!strcmp("S",escolha))
             {
@@ -381,67 +485,69 @@ public:
                 
                 if(roll<=33)
                 {
-                    evento_bom();
+                    evento_bom(saida);
                 }
 
                 if(roll>33&&roll<=67)
                 {
-                    evento_neutro();
+                    evento_neutro(saida);
                 }
                 if(roll>67)
                 {
-                    evento_ruim();
+                    evento_ruim(saida);
                 }
                 
             }
             else if(!strcmp("n",escolha)||!strcmp("N",escolha))
             {
+                Metrics::count(Counter::EventDeclined);
                 switch (roll_dice(d4))
                 {
                 case 1:
-                    cout<<"OK, para próxima sala, então... \n\n";
+                    saida += "OK, para próxima sala, então... \n\n";
                     break;
 
                 case 2:
-                    cout<<"Poxa... Eu estava curioso, estraga prazeres! \n\n";
+                    saida += "Poxa... Eu estava curioso, estraga prazeres! \n\n";
                     break;
                 
                 case 3:
-                    cout<<"Ah, eu amo o cheiro de uma oportunidade de exploração ignorada logo pela manhã. \n\n";
+                    saida += "Ah, eu amo o cheiro de uma oportunidade de exploração ignorada logo pela manhã. \n\n";
                     break;
                 case 4:
-                    cout<<"Vocês têm um talento especial para evitar justamente as partes mais interessantes da aventura, parabéns! \n\n";
+                    saida += "Vocês têm um talento especial para evitar justamente as partes mais interessantes da aventura, parabéns! \n\n";
                     break;
                 default:
-                    cout<<"Se vc está lendo isso a rebelião das máquinas já começou! Encontre John Connor, ele saberá o que fazer! \n\n";
+                    saida += "Se vc está lendo isso a rebelião das máquinas já começou! Encontre John Connor, ele saberá o que fazer! \n\n";
                     break;
                 }
                 
             }
             else
             {
+                Metrics::count(Counter::EventBadAnswer);
                 switch (roll_dice(d4))
                 {
                 case 1:
-                    cout<<"Esta não é uma aventura quântica! Há apenas DUAS opções!";
-                    evento_ruim();                    
+                    saida += "Esta não é uma aventura quântica! Há apenas DUAS opções!";
+                    evento_ruim(saida);                    
                     break;
                 
                 case 2:
-                    cout<<"Ora, Ora, temos um engraçadinho aqui! TOME! \n\n";
-                    evento_ruim();
+                    saida += "Ora, Ora, temos um engraçadinho aqui! TOME! \n\n";
+                    evento_ruim(saida);
                     break;
                 
                 case 3:
-                    cout<<"Vou acreditar que foi um erro inocente, mas só desta vez! \n\n";
+                    saida += "Vou acreditar que foi um erro inocente, mas só desta vez! \n\n";
                     break;
 
                 case 4:
-                    cout<<"'Miss Click', huh? Sei... Sei... Dessa vez passa... \n\n";
+                    saida += "'Miss Click', huh? Sei... Sei... Dessa vez passa... \n\n";
                     break;
 
                 default:
-                    cout<<"Se vc está lendo isso a rebelião das máquinas já começou! Encontre John Connor, ele saberá o que fazer! \n\n";
+                    saida += "Se vc está lendo isso a rebelião das máquinas já começou! Encontre John Connor, ele saberá o que fazer! \n\n";
                     break;
                 
                 }
@@ -451,63 +557,66 @@ public:
     
 };
 
+} // namespace encontros
 
-int main (void)
-{
-    setlocale(LC_ALL,"pt_br.UTF-8");
-    Evento_Randomico Entrar_na_sala;
-
-    for (int avancos = 0; avancos <= qtde_caminhos; avancos = avancos + Entrar_na_sala.escolhe_sala()){}
-}
+// Quem inclui este arquivo só pelas classes define JOGO_ENCONTROS_SEM_MAIN
+#ifndef JOGO_ENCONTROS_SEM_MAIN
 
-int roll_dice (int dice_num)
+// Uso: encontros [--gravar partida.rpl | --repetir partida.rpl] [--ritmo real | instantaneo | <fator>] [--metricas arquivo]
+// A semente dos dados e as respostas ficam no registro, então a repetição refaz a mesma partida.
+// Com --metricas, as métricas da partida (ver Metrics) são gravadas no arquivo ao final
+// A repetição usa o relógio instantâneo, a menos que outro seja pedido
+int main (int argc, char **argv)
 {
-    _sleep(3);
-    switch (dice_num)
+    setlocale(LC_ALL,"pt_br.UTF-8");
+    std::string modo, arquivo, relogio, metricas;
+    for (int i = 1; i + 1 < argc; i += 2)
     {
-    case 2:
-        srand(time(0));
-        dice_num = rand() % coin+1;        
-        break;
-        
-    case 4:
-        srand(time(0));
-        dice_num = rand() % d4+1;        
-        break;
-
-    case 6:
-        srand(time(0));
-        dice_num = rand() % d6+1;        
-        break;
-
-    case 8:
-        srand(time(0));
-        dice_num = rand() % d8+1;        
-        break;
-        
-    case 10:
-        srand(time(0));
-        dice_num = rand() % d10+1;        
-        break;
-        
-    case 12:
-        srand(time(0));
-        dice_num = rand() % d12+1;        
-        break;
-
-    case 20:
-        srand(time(0));
-        dice_num = rand() % d20+1;       
-        break;
-        
-    case 100:
-        srand(time(0));
-        dice_num = rand() % d100+1;        
-        break;
+        std::string opcao = argv[i];
+        if (opcao == "--ritmo")
+            relogio = argv[i + 1];
+        else if (opcao == "--metricas")
+            metricas = argv[i + 1];
+        else
+        {
+            modo = opcao;
+            arquivo = argv[i + 1];
+        }
+    }
+    if (relogio.empty())
+        relogio = modo == "--repetir" ? "instantaneo" : "real";
 
-        
-    default:
-        break;
+    ReplayLog registro;
+    if (modo == "--repetir" && !registro.load(arquivo))
+    {
+        cerr<<"Não foi possível ler o registro "<<arquivo<<"\n";
+        return 1;
     }
-    return dice_num;
+    uint64_t semente = modo == "--repetir" ? registro.getSeed() : Dados::sementeAleatoria();
+    dados_padrao().semear(semente);
+    ReplayCursor repeticao(registro);
+
+    encontros::Evento_Randomico Entrar_na_sala;
+    Entrar_na_sala.setMasmorra(Masmorra(semente)); // A mesma semente dos dados: a repetição percorre a mesma masmorra
+    if (relogio == "instantaneo")
+        Entrar_na_sala.setRitmo(Ritmo::instantaneo());
+    else if (relogio != "real")
+        Entrar_na_sala.setRitmo(Ritmo::acelerado(std::strtod(relogio.c_str(), nullptr)));
+    if (modo == "--gravar")
+    {
+        registro.begin(semente, 0);
+        Entrar_na_sala.gravarEm(&registro);
+    }
+    if (modo == "--repetir")
+        Entrar_na_sala.repetirDe(&repeticao);
+
+    for (int avancos = 0; avancos <= qtde_caminhos; avancos = avancos + Entrar_na_sala.escolhe_sala()){}
+
+    if (modo == "--gravar" && !registro.save(arquivo))
+        cerr<<"Não foi possível gravar o registro "<<arquivo<<"\n";
+    if (!metricas.empty() && !Metrics::exportTo(metricas))
+        cerr<<"Não foi possível gravar as métricas em "<<metricas<<"\n";
+    TRACE_DUMP("encontros_trace.json");
 }
+
+#endif
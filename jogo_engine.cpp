@@ -1,8 +1,24 @@
+#include <chrono>
 #include <iostream>
-#include <map>
 #include <string>
 #include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <ctime> // Include ctime for time function
+#include "jogo_analise.cpp"
+#include "jogo_assets.cpp"
+#include "jogo_decisoes.cpp"
+#include "jogo_entrada.cpp"
+#include "jogo_corrotinas.cpp"
+#include "jogo_historia.cpp"
+#include "jogo_historia_padrao.cpp"
+#include "jogo_metricas.cpp"
+#include "jogo_rastreio.cpp"
+#include "jogo_render.cpp"
+#include "jogo_replay.cpp"
+#include "jogo_sessao.cpp"
 
 /*
 Função: Modela uma opção de interação disponível dentro de uma cena. Cada escolha pode ter uma descrição e uma referência à cena ou efeito que ela provoca, possibilitando a ramificação da narrativa.
@@ -10,13 +26,18 @@ NEW: As escolhas podem acionar eventos aleatórios, modificar atributos do jogad
 */
 class Choice {
     public:
-        Choice(const std::string& text, int nextSceneId)
-            : description(text), nextSceneId(nextSceneId) {}
-        std::string getDescription() const { return description; }
+        // "condition" e "effect" usam a linguagem de jogo_decisoes.cpp; vazios, a escolha está sempre disponível e não muda nada
+        Choice(const std::string& text, int nextSceneId, const std::string& condition = "", const std::string& effect = "")
+            : description(text), nextSceneId(nextSceneId), condition(condition), effect(effect) {}
+        std::string_view getDescription() const { return description; }
         int getTargetSceneId() const { return nextSceneId; }
+        const std::string& getCondition() const { return condition; }
+        const std::string& getEffect() const { return effect; }
     private:
         std::string description;
         int nextSceneId;
+        std::string condition;
+        std::string effect;
 };
 
 /*
@@ -25,33 +46,103 @@ Função: Representa um “capítulo” ou momento da história. Cada cena pode
 class Scene {
     public:
         Scene() : asciiArt(""), narrative("") {} // Default constructor
-        Scene(const std::string &asciiArt, const std::string &narrative)
+        // A arte não é copiada: ela precisa viver em um AssetRegistry (ou outro armazenamento estável) enquanto a cena existir
+        Scene(std::string_view asciiArt, const std::string &narrative)
             : asciiArt(asciiArt), narrative(narrative) {}
     
-        // Adiciona uma escolha à cena
-        void addChoice(const std::string &option, int nextSceneId) {
-            choices.push_back({option, nextSceneId});
+        // Adiciona uma escolha à cena, opcionalmente com condição e efeitos
+        void addChoice(const std::string &option, int nextSceneId, const std::string &condition = "", const std::string &effect = "") {
+            choices.push_back({option, nextSceneId, condition, effect});
         }
     
-        // Exibe a cena na tela
+        // Exibe a cena na tela (o quadro é montado inteiro e enviado de uma vez)
         void display() const {
-            std::cout << asciiArt << "\n" << narrative << "\n";
+            Metrics::count(Counter::SceneDisplays);
+            std::string frame;
+            frame.append(asciiArt).append("\n").append(narrative).append("\n");
             if (!choices.empty()) {
-                std::cout << "\nEscolhas:\n";
+                frame += "\nEscolhas:\n";
                 for (size_t i = 0; i < choices.size(); i++) {
-                    std::cout << (i + 1) << ": " << choices[i].getDescription() << "\n";
+                    frame.append(std::to_string(i + 1)).append(": ").append(choices[i].getDescription()).append("\n");
                 }
             }
+            std::cout.write(frame.data(), static_cast<std::streamsize>(frame.size()));
         }
         // Retorna as escolhas da cena
         const std::vector<Choice>& getChoices() const {
             return choices;
         }
+        std::string_view getAsciiArt() const { return asciiArt; }
+        const std::string& getNarrative() const { return narrative; }
+
+        // Final da história (game over, epílogo), mesmo que ofereça voltar ao início
+        void setEnding(bool value) { ending = value; }
+        bool isEnding() const { return ending; }
     
     private:
-        std::string asciiArt;
+        std::string_view asciiArt;
         std::string narrative;
         std::vector<Choice> choices;
+        bool ending = false;
+};
+
+/*
+DecisionEngine/BranchingEngine
+Função: Avalia as condições e aplica os efeitos das escolhas (bytecode de jogo_decisoes.cpp) sobre o estado da sessão, decidindo quais escolhas de uma cena estão disponíveis e qual cena vem a seguir. Cenas sem condições seguem um caminho direto, sem executar nada.
+*/
+class DecisionEngine {
+    public:
+        // Máscara das escolhas disponíveis na cena (bit i = escolha i, a partir de 0). Só as primeiras
+        // MAX_CONDITIONAL_CHOICES escolhas podem ter condição; as seguintes estão sempre disponíveis
+        // e ficam fora da máscara
+        static uint32_t visibleChoices(const StoryGraph &graph, int sceneId, const WorldState &world) {
+            int count = graph.getChoiceCount(sceneId);
+            uint32_t all = count >= 32 ? 0xFFFFFFFFu : (1u << count) - 1;
+            if (!graph.isConditional(sceneId))
+                return all;
+            uint32_t visible = all;
+            for (int i = 0; i < count && i < MAX_CONDITIONAL_CHOICES; i++) {
+                const uint8_t *condition = graph.getChoiceCondition(sceneId, i);
+                if (condition && !evaluateCondition(condition, world))
+                    visible &= ~(1u << i);
+            }
+            return visible;
+        }
+
+        // Quantidade de escolhas disponíveis na cena
+        static int visibleChoiceCount(const StoryGraph &graph, int sceneId, const WorldState &world) {
+            if (!graph.isConditional(sceneId))
+                return graph.getChoiceCount(sceneId);
+            int total = graph.getChoiceCount(sceneId);
+            int count = total > MAX_CONDITIONAL_CHOICES ? total - MAX_CONDITIONAL_CHOICES : 0;
+            for (uint32_t mask = visibleChoices(graph, sceneId, world); mask; mask &= mask - 1)
+                count++;
+            return count;
+        }
+
+        // Aplica a escolha "choiceId" (a partir de 1, contando só as disponíveis) à sessão: executa os efeitos
+        // e devolve a cena seguinte, ou -1 (sem alterar nada) se a escolha não estiver disponível
+        int evaluateDecision(const StoryGraph &graph, GameSession &session, int choiceId) const {
+            int id = session.sceneId;
+            int count = graph.getChoiceCount(id);
+            if (choiceId <= 0 || choiceId > count)
+                return -1;
+            int index = choiceId - 1;
+            if (graph.isConditional(id)) {
+                uint32_t mask = visibleChoices(graph, id, session.world);
+                index = -1;
+                for (int i = 0; i < count; i++)
+                    if ((i >= MAX_CONDITIONAL_CHOICES || (mask >> i & 1u)) && --choiceId == 0) {
+                        index = i;
+                        break;
+                    }
+                if (index < 0)
+                    return -1;
+            }
+            if (const uint8_t *effect = graph.getChoiceEffect(id, index))
+                applyEffect(effect, session.world);
+            return graph.getChoiceTarget(id, index);
+        }
 };
 
 /*
@@ -61,410 +152,557 @@ class StoryManager {
     public:
         // Adiciona uma cena com um identificador único
         void addScene(int id, const Scene &scene) {
+            if (id < 0)
+                return;
+            if (id >= static_cast<int>(scenes.size())) {
+                scenes.resize(id + 1);
+                present.resize(id + 1, false);
+            }
             scenes[id] = scene;
+            present[id] = true;
         }
         
         // Retorna um ponteiro para a cena correspondente ao id
         Scene* getScene(int id) {
-            auto it = scenes.find(id);
-            if (it != scenes.end())
-                return &(it->second);
+            if (id >= 0 && id < static_cast<int>(scenes.size()) && present[id])
+                return &scenes[id];
             return nullptr;
         }
+
+        // Versão somente leitura
+        const Scene* getScene(int id) const {
+            if (id >= 0 && id < static_cast<int>(scenes.size()) && present[id])
+                return &scenes[id];
+            return nullptr;
+        }
+
+        // Monta o grafo compacto (StoryGraph) a partir das cenas adicionadas por addScene.
+        // Precisa ser chamado depois da última addScene e antes de jogar; as consultas abaixo usam apenas o grafo.
+        // Uma condição ou efeito que não compila recusa a história inteira ("error" diz a cena, a escolha e o
+        // motivo) em vez de deixar uma escolha condicionada sempre disponível; o grafo anterior é mantido.
+        bool buildGraph(std::string &error, int startSceneId = 1) {
+            StoryCompiler compiler;
+            compiler.setStartScene(startSceneId);
+            bool ok = true;
+            forEachScene([&](int id, const Scene &scene) {
+                compiler.addScene(id, scene.getAsciiArt(), scene.getNarrative());
+                if (scene.isEnding())
+                    compiler.markEnding();
+                for (const Choice &choice : scene.getChoices()) {
+                    compiler.addChoice(choice.getDescription(), choice.getTargetSceneId());
+                    std::string motivo;
+                    if ((!choice.getCondition().empty() && !compiler.setChoiceCondition(choice.getCondition(), motivo)) ||
+                        (!choice.getEffect().empty() && !compiler.setChoiceEffect(choice.getEffect(), motivo))) {
+                        if (ok)
+                            error = "cena " + std::to_string(id) + ", escolha '" + std::string(choice.getDescription()) + "': " + motivo;
+                        ok = false;
+                    }
+                }
+            });
+            if (!ok)
+                return false;
+            graph.adopt(compiler.build());
+            analysis.analyze(graph);
+            return true;
+        }
+
+        // Carrega uma história gerada pelo jogo_compilador mapeando o arquivo em memória
+        bool loadCompiled(const std::string &path) {
+            bool loaded = graph.load(path);
+            analysis.analyze(graph);
+            return loaded;
+        }
+
+        // Usa uma imagem de história que vive por todo o programa, como a HISTORIA_PADRAO gerada durante a
+        // compilação. Na versão de quiosque (JOGO_QUIOSQUE) a análise é pulada: as tabelas já foram
+        // conferidas pelo compilador e assim nada é alocado ao iniciar.
+        bool attachFixed(const void *data, size_t size) {
+            graph.unload();
+            bool attached = graph.attach(data, size);
+#ifndef JOGO_QUIOSQUE
+            analysis.analyze(graph);
+#endif
+            return attached;
+        }
+
+        // Grafo usado pelo loop do jogo e pelas análises
+        const StoryGraph& getGraph() const { return graph; }
+
+        // Resultados da análise feita quando a história foi montada ou carregada
+        const StoryAnalysis& getAnalysis() const { return analysis; }
+
+        // Menor quantidade de escolhas da cena até um final (StoryAnalysis::UNREACHABLE se não houver)
+        int getDistanceToEnding(int id) const { return analysis.getDistanceToEnding(id); }
+
+        int getStartSceneId() const { return graph.getStartSceneId(); }
+        // A cena existe e pode ser jogada (ver StoryGraph::checkScene); cenas com registros corrompidos contam como inexistentes
+        bool hasScene(int id) const { return graph.checkScene(id); }
+
+        // Quantidade de escolhas da cena (a cena precisa existir), incluindo as que dependem de condições
+        int getChoiceCount(int id) const { return graph.getChoiceCount(id); }
+
+        // Escolhas disponíveis na cena atual da sessão: quantidade e máscara (bit i = escolha i)
+        int getVisibleChoiceCount(const GameSession &session) const {
+            return DecisionEngine::visibleChoiceCount(graph, session.sceneId, session.world);
+        }
+        uint32_t getVisibleChoices(const GameSession &session) const {
+            return DecisionEngine::visibleChoices(graph, session.sceneId, session.world);
+        }
+
+        // Cena alvo da escolha "index" (começando em 0)
+        int getChoiceTarget(int id, int index) const { return graph.getChoiceTarget(id, index); }
+
+        // Inicia uma sessão na cena inicial da história, com o gerador de dados na semente "seed"
+        void startSession(GameSession &session, uint64_t seed = 0) const {
+            session = GameSession();
+            session.sceneId = getStartSceneId();
+            session.dados.semear(seed);
+        }
+
+        // Grava a sessão em uma cópia binária ligada a esta história (ver SessionSnapshot)
+        void saveSession(const GameSession &session, SessionSnapshot &snapshot) const {
+            snapshot.save(session, graph.getFingerprint());
+        }
+
+        // Retoma uma sessão gravada; cópias inválidas, de outra história ou paradas em uma cena que
+        // não existe mais são recusadas sem alterar a sessão
+        SessionSnapshot::Status restoreSession(const SessionSnapshot &snapshot, GameSession &session) const {
+            SessionSnapshot::Status status = snapshot.check(graph.getFingerprint());
+            if (status == SessionSnapshot::Status::Ok && !hasScene(snapshot.getSceneId()))
+                status = SessionSnapshot::Status::OtherStory;
+            if (status != SessionSnapshot::Status::Ok)
+                return status;
+            return snapshot.restore(session, graph.getFingerprint());
+        }
+
+        // Aplica a escolha (começando em 1, entre as disponíveis) à sessão, com seus efeitos;
+        // retorna false, sem alterar nada, se ela for inválida
+        bool applyChoice(GameSession &session, int choice) const {
+            if (!hasScene(session.sceneId))
+                return false;
+            int next = decisions.evaluateDecision(graph, session, choice);
+            if (next < 0)
+                return false;
+            session.sceneId = next;
+            return true;
+        }
+
+        // Percorre as cenas adicionadas por addScene em ordem de id (usado pelo jogo_compilador)
+        template <class Visitor>
+        void forEachScene(Visitor &&visit) const {
+            for (size_t id = 0; id < scenes.size(); id++)
+                if (present[id])
+                    visit(static_cast<int>(id), scenes[id]);
+        }
     
     private:
-        std::map<int, Scene> scenes;
+        // Cenas de autoria em um vetor indexado pelo id; o jogo consulta o grafo
+        std::vector<Scene> scenes;
+        std::vector<bool> present;
+        StoryGraph graph;
+        StoryAnalysis analysis;
+        DecisionEngine decisions;
 };
 
 /*
-Função: Responsável por capturar e interpretar a entrada do usuário. Essa classe pode validar as opções digitadas ou selecionadas, transformando a entrada em comandos ou escolhas que serão processadas pelo StoryManager.
+PlaythroughResult
+Função: Guarda o resultado de uma partida executada sem terminal: o caminho de cenas percorrido, a cena final, a quantidade de passos e o motivo do encerramento.
 */
-class InputHandler {
+struct PlaythroughResult {
+    enum class EndReason {
+        Terminal,       // Cena sem escolhas (ou sem escolhas disponíveis)
+        SceneNotFound,  // Escolha aponta para uma cena inexistente
+        InputExhausted, // A política/fluxo de escolhas não forneceu mais opções
+        StepLimit       // Limite de passos atingido (a história tem ciclos)
+    };
+
+    std::vector<int> path; // Cenas visitadas, na ordem (inclui a inicial)
+    int finalSceneId = 0;
+    int steps = 0;          // Escolhas válidas aplicadas
+    int invalidChoices = 0; // Escolhas fora do intervalo, ignoradas como no modo interativo
+    EndReason reason = EndReason::Terminal;
+    GameSession session;    // Estado no fim da partida; gravado com saveSession, vira ponto de reinício
+};
+
+/*
+HeadlessRunner
+Função: Executa partidas sem entrada/saída de terminal, percorrendo o mesmo StoryManager usado pelo Game::run. As escolhas vêm de uma política (função que recebe a cena atual e devolve a opção, começando em 1, ou 0 para encerrar) ou de uma sequência fixa de escolhas.
+O resultado pode ser reaproveitado entre execuções para não realocar o caminho a cada partida.
+*/
+class HeadlessRunner {
     public:
-        int getUserChoice() {
-            int choice;
-            std::cout << "\nDigite sua escolha: ";
-            std::cin >> choice;
-            return choice;
+        explicit HeadlessRunner(const StoryManager &story, int maxSteps = 1000)
+            : story(story), startSceneId(story.getStartSceneId()), maxSteps(maxSteps) {}
+        HeadlessRunner(const StoryManager &story, int startSceneId, int maxSteps)
+            : story(story), startSceneId(startSceneId), maxSteps(maxSteps) {}
+
+        // Registrar o caminho custa uma escrita por passo; desligue quando só a cena final interessa
+        void setRecordPath(bool record) { recordPath = record; }
+
+        // Executa uma partida; policy(sceneId, choiceCount, step) devolve a escolha (1..choiceCount) ou 0 para parar
+        template <class Policy>
+        void run(Policy &&policy, PlaythroughResult &result) const {
+            GameSession start;
+            story.startSession(start);
+            start.sceneId = startSceneId;
+            run(policy, result, start);
+        }
+
+        // Continua uma partida a partir de uma sessão (ex.: restaurada de um SessionSnapshot), sem repetir
+        // os passos que levaram até ela; o limite de passos conta só os desta execução
+        template <class Policy>
+        void run(Policy &&policy, PlaythroughResult &result, const GameSession &start) const {
+            result.path.clear();
+            result.steps = 0;
+            result.invalidChoices = 0;
+
+            GameSession &session = result.session;
+            session = start;
+            int &currentSceneId = session.sceneId;
+            while (true) {
+                if (!story.hasScene(currentSceneId)) {
+                    result.reason = PlaythroughResult::EndReason::SceneNotFound;
+                    break;
+                }
+                if (recordPath)
+                    result.path.push_back(currentSceneId);
+
+                int choiceCount = story.getVisibleChoiceCount(session);
+                if (choiceCount == 0) {
+                    result.reason = PlaythroughResult::EndReason::Terminal;
+                    break;
+                }
+                if (result.steps >= maxSteps) {
+                    result.reason = PlaythroughResult::EndReason::StepLimit;
+                    break;
+                }
+
+                int choice = policy(currentSceneId, choiceCount, result.steps);
+                if (choice == 0) {
+                    result.reason = PlaythroughResult::EndReason::InputExhausted;
+                    break;
+                }
+                if (!story.applyChoice(session, choice)) {
+                    // Mesmo tratamento do modo interativo: a escolha é descartada e a cena se repete
+                    if (++result.invalidChoices > maxSteps) {
+                        result.reason = PlaythroughResult::EndReason::StepLimit;
+                        break;
+                    }
+                    continue;
+                }
+                result.steps++;
+            }
+            result.finalSceneId = currentSceneId;
         }
+
+        // Executa uma partida consumindo uma sequência fixa de escolhas
+        void run(const std::vector<int> &choices, PlaythroughResult &result) const {
+            size_t next = 0;
+            run([&](int, int, int) {
+                return next < choices.size() ? choices[next++] : 0;
+            }, result);
+        }
+
+        PlaythroughResult run(const std::vector<int> &choices) const {
+            PlaythroughResult result;
+            run(choices, result);
+            return result;
+        }
+
+        // Executa várias partidas seguidas reaproveitando o mesmo resultado;
+        // makePolicy(i) cria a política da partida i e onResult(i, result) recebe cada resultado
+        template <class PolicyFactory, class ResultSink>
+        void runBatch(size_t count, PolicyFactory &&makePolicy, ResultSink &&onResult) const {
+            PlaythroughResult result;
+            for (size_t i = 0; i < count; i++) {
+                run(makePolicy(i), result);
+                onResult(i, result);
+            }
+        }
+
+    private:
+        const StoryManager &story;
+        int startSceneId;
+        int maxSteps;
+        bool recordPath = true;
 };
 
 /*
-DecisionEngine/BranchingEngine
-Função: Se a sua narrativa tiver regras mais complexas ou variáveis que influenciem o curso da história (por exemplo, estados que persistem durante o jogo), uma classe dedicada para processar essas decisões pode ser útil. Ela pode avaliar condições e determinar a próxima cena com base em múltiplos fatores.
+ReplayRunner
+Função: Refaz sem terminal uma partida gravada em um ReplayLog: parte da mesma semente e aplica as mesmas escolhas ao mesmo StoryManager, chegando ao mesmo estado da partida original, bit a bit (verify confere com o estado final gravado). Não aloca, então serve para reproduzir registros em massa.
+seek salta para qualquer passo partindo do checkpoint mais próximo do registro, refazendo no máximo um intervalo de eventos.
 */
-class DecisionEngine {
+class ReplayRunner {
     public:
-        int evaluateDecision(const Scene& scene, int choiceId);
+        enum class Status {
+            Ok,
+            OtherStory, // O registro (ou uma cópia nele) é de outra história
+            BadEvent,   // Escolha indisponível no ponto em que foi gravada, ou registro truncado
+            Mismatch    // A partida refeita terminou em um estado diferente do gravado
+        };
+
+        explicit ReplayRunner(const StoryManager &story) : story(story) {}
+
+        // Refaz os primeiros "steps" eventos do registro (todos, se "steps" for maior que o registro)
+        Status replay(const ReplayLog &log, GameSession &session, uint32_t steps = UINT32_MAX) const {
+            if (log.getStory() != story.getGraph().getFingerprint())
+                return Status::OtherStory;
+            story.startSession(session, log.getSeed());
+            ReplayCursor cursor(log);
+            return advance(cursor, steps, session);
+        }
+
+        // Estado da partida antes do evento "step" (0 = início), partindo do checkpoint mais próximo
+        Status seek(const ReplayLog &log, uint32_t step, GameSession &session) const {
+            const ReplayLog::Checkpoint *checkpoint = log.findCheckpoint(step);
+            if (!checkpoint)
+                return replay(log, session, step);
+            if (story.restoreSession(checkpoint->snapshot, session) != SessionSnapshot::Status::Ok)
+                return Status::OtherStory;
+            ReplayCursor cursor(log, *checkpoint);
+            return advance(cursor, step - checkpoint->step, session);
+        }
+
+        // Refaz o registro inteiro e confere o estado final gravado (se houver)
+        Status verify(const ReplayLog &log, GameSession &session) const {
+            Status status = replay(log, session);
+            if (status != Status::Ok || !log.hasFinalState())
+                return status;
+            SessionSnapshot end;
+            story.saveSession(session, end);
+            return std::memcmp(end.data(), log.getFinalState().data(), end.size()) == 0 ? Status::Ok : Status::Mismatch;
+        }
+
+    private:
+        Status advance(ReplayCursor &cursor, uint32_t steps, GameSession &session) const {
+            uint32_t value;
+            for (uint32_t i = 0; i < steps && cursor.next(value); i++) {
+                if (value == REPLAY_RESTORE) {
+                    SessionSnapshot snapshot;
+                    if (!cursor.nextSnapshot(snapshot))
+                        return Status::BadEvent;
+                    if (story.restoreSession(snapshot, session) != SessionSnapshot::Status::Ok)
+                        return Status::OtherStory;
+                } else if (!story.applyChoice(session, static_cast<int>(value))) {
+                    return Status::BadEvent;
+                }
+            }
+            return Status::Ok;
+        }
+
+        const StoryManager &story;
 };
 
+// ASCII arts padrão do jogo (ARTES_PADRAO) em um registro por nome. É montado uma única vez por processo, na
+// primeira chamada, e só guarda o índice: os textos continuam nos dados somente leitura do executável.
+inline const AssetRegistry& defaultAsciiArts() {
+    static const AssetRegistry registry = [] {
+        AssetRegistry arts;
+        for (const FixedArt &art : ARTES_PADRAO)
+            arts.borrow(art.name, art.text);
+        arts.freeze();
+        return arts;
+    }();
+    return registry;
+}
+
 /*
 Game/Engine
 Função: Classe principal que gerencia o ciclo do jogo. Ela inicia a aplicação, mantém o loop principal, atualiza o estado do jogo e delega chamadas para outras classes (por exemplo, recebendo input e atualizando a narrativa).
 */
 class Game {
     public:
+        // Usa a história padrão, compilada junto com o programa (HISTORIA_PADRAO): nada é montado nem alocado aqui
         Game() {
-            // Inicializa o map de ASCII arts padrão
-            asciiArts["montanhas"] = R"(
-         /\          /\          /\
-        /  \   /\   /  \   /\   /  \
-       /    \ /  \ /    \ /  \ /    \
-      /      \    /      \    /      \
-     /        \  /        \  /        \
-    /  /\      \/          \/      /\   \
-   /  /  \      |   ~~~~   |      /  \   \
-  /__/____\     |  ~~~~~~  |     /____\___\
-                \~~~~~~~~~~/ 
-                 \~~~~~~~~/ 
-                  \~~~~~~/ 
-                   \~~~~/ 
-                    \~~/ 
-                     \/ 
-
-            )";
-
-            asciiArts["castelo"] = R"(
-                                    |>>>                              
-                                  |                                 
-                    |>>>      _  _|_  _         |>>>                
-                    |        |;| |;| |;|        |                   
-                _  _|_  _    \\.    .  /    _  _|_  _               
-               |;|_|;|_|;|    \\:. ,  /    |;|_|;|_|;|              
-               \\..      /    ||;   . |    \\.    .  /              
-                \\.  ,  /     ||:  .  |     \\:  .  /               
-                 ||:   |_   _ ||_ . _ | _   _||:   |                
-                 ||:  .|||_|;|_|;|_|;|_|;|_|;||:.  |                
-                 ||:   ||.    .     .      . ||:  .|                
-                 ||: . || .     . .   .  ,   ||:   |       \,/      
-                 ||:   ||:  ,  _______   .   ||: , |            /`\ 
-                 ||:   || .   /+++++++\    . ||:   |                
-                 ||:   ||.    |+++++++| .    ||: . |                
-              __ ||: . ||: ,  |+++++++|.  . _||_   |                
-     ____--`~    '--~~__|.    |+++++__|----~    ~`---,              
--~--~                   ~---__|,--~'                  ~~----_____-~'
-            )";
-            asciiArts["endgame"] = R"(
- <>=======() 
-(/\___   /|\\          ()==========<>_
-      \_/ | \\        //|\   ______/ \)
-        \_|  \\      // | \_/
-          \|\/|\_   //  /\/
-           (oo)\ \_//  /
-          //_/\_\/ /  |
-         @@/  |=\  \  |
-              \_=\_ \ |
-                \==\ \|\_ snd
-             __(\===\(  )\
-            (((~) __(_/   |
-                 (((~) \  /
-                 ______/ /
-                 '------'
-            )";
-            asciiArts["gameover"] = R"(
-            ⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀                                    .""--..__
-                     _                     []       ``-.._
-                  .'` `'.                  ||__           `-._
-                 /    ,-.\                 ||_ ```---..__     `-.
-                /    /:::\\               /|//}          ``--._  `.
-                |    |:::||              |////}                `-. \
-                |    |:::||             //'///                    `.\
-                |    |:::||            //  ||'                      `|
-        jgs     /    |:::|/        _,-//\  ||
-        hh     /`    |:::|`-,__,-'`  |/  \ ||
-             /`  |   |'' ||           \   |||
-           /`    \   |   ||            |  /||
-         |`       |  |   |)            \ | ||
-        |          \ |   /      ,.__    \| ||
-        /           `         /`    `\   | ||
-       |                     /        \  / ||
-       |                     |        | /  ||
-       /         /           |        `(   ||
-      /          .           /          )  ||
-     |            \          |     ________||
-    /             |          /     `-------.|
-   |\            /          |              ||
-   \/`-._       |           /              ||
-    //   `.    /`           |              ||
-   //`.    `. |             \              ||
-  ///\ `-._  )/             |              ||
- //// )   .(/               |              ||
- ||||   ,'` )               /              //
- ||||  /                    /             || 
- `\\` /`                    |             // 
-     |`                     \            ||  
-    /                        |           //  
-  /`                          \         //   
-/`                            |        ||    
-`-.___,-.      .-.        ___,'        (/    
-         `---'`   `'----'`
-
-            )";
-            asciiArts["mago_ataque"] = R"(
-                    '             .           .
-    o       '   o  .     '   . O
-'   .   ' .   _____  '    .      .
-    .     .   .mMMMMMMMm.  '  o  '   .
-'   .     .MMXXXXXXXXXMM.    .   ' 
-.       . /XX77:::::::77XX\ .   .   .
-    o  .  ;X7:::''''''':::7X;   .  '
-'    . |::'.:'        '::| .   .  .
-    .   ;:.:.            :;. o   .
-'     . \'.:            /.    '   .
-    .     `.':.        .'.  '    .
-    '   . '  .`-._____.-'   .  . '  .
-    ' o   '  .   O   .   '  o    '
-    . ' .  ' . '  ' O   . '  '   '
-    . .   '    '  .  '   . '  '
-        . .'..' . ' ' . . '.  . '
-        `.':.'        ':'.'.'
-        `\\_  |     _//'
-            \(  |\    )/
-            //\ |_\  /\\
-            (/ /\(" )/\ \)
-            \/\ (  ) /\/
-                |(  )|
-                | \( \
-                |  )  \
-                |      \
-                |       \
-                |        `.__,
-                \_________.-'Ojo/gnv
-            )";
-            asciiArts["dragao"] = R"(
-       ^    ^
-               / \  //\
- |\___/|      /   \//  .\
- /O  O  \__  /    //  | \ \
-/     /  \/_/    //   |  \  \
-@___@'    \/_   //    |   \   \ 
-   |       \/_ //     |    \    \ 
-   |        \///      |     \     \ 
-  _|_ /   )  //       |      \     _\
- '/,_ _ _/  ( ; -.    |    _ _\.-~        .-~~~^-.
- ,-{        _      `-.|.-~-.           .~         `.
-  '/\      /                 ~-. _ .-~      .-~^-.  \
-     `.   {            }                   /      \  \
-   .----~-.\        \-'                 .~         \  `. \^-.
-  ///.----..>    c   \             _ -~             `.  ^-`   ^-_
-    ///-._ _ _ _ _ _ _}^ - - - - ~                     ~--,   .-~
-                                                          /.-'
-⠀⠀
-            )";
-            asciiArts["bruxa"] = R"(
-                    Ash nazg durbatulûk
-                    agh burzum-ishi
-(       "     )   krimpatul
-( _  *           Gûlburz agh dûmûrz
-    * (     /      \    ___
-        "     "        _/ /
-        (   *  )    ___/   |
-        )   "     _ o)'-./__
-        *  _ )    (_, . $$$
-        (  )   __ __ 7_ $$$$
-        ( :  { _)  '---  $\
-    ______'___//__\   ____, \
-    )           ( \_/ _____\_
-    .'             \   \------''.
-    |='           '=|  |         )
-    |               |  |  .    _/
-    \    (. ) ,   /  /__I_____\
-snd  '._/_)_(\__.'   (__,(__,_]
-    @---()_.'---@
-            )";
-            asciiArts["ogro"] = R"(
-            __,='`````'=/__
-            '//  (o) \(o) \ `'         _,-,
-            //|     ,_)   (`\      ,-'`_,-\
-        ,-~~~\  `'==='  /-,      \==```` \__
-        /        `----'     `\     \       \/
-    ,-`                  ,   \  ,.-\       \
-    /      ,               \,-`\`_,-`\_,..--'\
-    ,`    ,/,              ,>,   )     \--`````\
-    (      `\`---'`  `-,-'`_,<   \      \_,.--'`
-    `.      `--. _,-'`_,-`  |    \
-    [`-.___   <`_,-'`------(    /
-    (`` _,-\   \ --`````````|--`
-        >-`_,-`\,-` ,          |
-    <`_,'     ,  /\          /
-    `  \/\,-/ `/  \/`\_/V\_/
-        (  ._. )    ( .__. )
-        |      |    |      |
-        \,---_|    |_---./
-        ooOO(_)    (_)OOoo
-            )";
-            asciiArts["mago"] = R"(
-              _,._      
-  .||,       /_ _\\     
- \.`',/      |'L'| |    
- = ,. =      | -,| L    
- / || \    ,-'\"/,'`.   
-   ||     ,'   `,,. `.  
-   ,|____,' , ,;' \| |  
-  (3|\    _/|/'   _| |  
-   ||/,-''  | >-'' _,\\ 
-   ||'      ==\ ,-'  ,' 
-   ||       |  V \ ,|   
-   ||       |    |` |   
-   ||       |    |   \  
-   ||       |    \    \ 
-   ||       |     |    \
-   ||       |      \_,-'
-   ||       |___,,--")_\
-   ||         |_|   ccc/
-   ||        ccc/       
-   ||                hjm
-            )";
-            asciiArts["cavaleiro"] = R"(
-    / \
-    | |
-    |.|
-    |.|
-    |:|      __
- ,_|:|_,   /  )
-   (Oo    / _I_
-    +\ \  || __|
-       \ \||___|
-         \ /.:.\-\
-           |.:. /-----\
-           |___|::oOo::|
-          /   |:<_T_>:|
-         |_____\ ::: /
-         | |  \ \:/
-         | |   | |
-         \ /   | \___
-         / |   \_____\
-            )";
-            asciiArts["intro"] = R"(
-;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
-;;;;;;;;;;;;;;;;-' ___      '-;;;;;;;;;;;;;;;;
-;;;;;;;;;;;;-'    `'-.`'-.      '-;;;;;;;;;;;;
-;;;;;;;;;;'           )   `\       ';;;;;;;;;;
-;;;;;;;;'            /      \   ^V^  ';;;;;;;;
-;;;;;;;           __/________\__       ;;;;;;;
-;;;;;;  ^V^      '--/}}}}}}"}}--'       ;;;;;;
-;;;;;              {{{{{{  aa\__         ;;;;;
-;;;;;              }}}}} ,___ __}        ;;;;;
-;;;;;             {{{{{\  \_//           ;;;;;
-;;;;;              }}}}//'--u            ;;;;;
-;;;;;        _     .--'`U\               ;;;;;
-;;;;;   ::::| \   (   _,\\\              ;;;;;
-;;;;;;  ::::|  |===\  \\=\))=======D    ;;;;;;
-;;;;;;; ::::|_/     `> \\              ;;;;;;;
-;;;;;;;;.           /__//            .;;;;;;;;
-;;;;;;;;;;.         Y\_\\_         .;;;;;;;;;;
-;;;;;;;;;;;;-._                _.-;;;;;;;;;;;;
-;;;;;;;jgs;;;;;;-.          .-;;;;;;;;;;;;;;;;
-;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
-;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;; 
-            )";
-            asciiArts["demo"] = R"(
-                     ,-.
-       ___,---.__          /'|`\          __,---,___
-    ,-'    \`    `-.____,-'  |  `-.____,-'    //    `-.
-  ,'        |           ~'\     /`~           |        `.
- /      ___//              `. ,'          ,  , \___      \
-|    ,-'   `-.__   _         |        ,    __,-'   `-.    |
-|   /          /\_  `   .    |    ,      _/\          \   |
-\  |           \ \`-.___ \   |   / ___,-'/ /           |  /
- \  \           | `._   `\\  |  //'   _,' |           /  /
-  `-.\         /'  _ `---'' , . ``---' _  `\         /,-'
-     ``       /     \    ,='/ \`=.    /     \       ''
-             |__   /|\_,--.,-.--,--._/|\   __|
-             /  `./  \\`\ |  |  | /,//' \,'  \
-eViL        /   /     ||--+--|--+-/-|     \   \
-           |   |     /'\_\_\ | /_/_/`\     |   |
-            \   \__, \_     `~'     _/ .__/   /
-             `-._,-'   `-._______,-'   `-._,-'
-            )";
-            asciiArts["template"] = R"(
-            )";
-            // Cadastra as cenas utilizando as ASCII arts definidas
-            Scene scene1(asciiArts["intro"], "Em um reino muito distante chamado Exandria uma bruxa muito má estava selada em uma rocha e após 100 anos o selo enfraqueceu e ela se libertou...Após se libertar, a Bruxa voou em direção ao reino de Exandria que era comandado pelos descendentes daqueles que a selaram, chegando lá ela percebeu que estava ocorrendo um festival, onde os Reis e rainhas de todos os reinos se reuniam para celebrar a paz entre eles, aproveitando essa oportunidade a bruxa esperou o momento em que o rei e rainha do reino anfitrião apareceriam para declarar inicio ao festival e os matou na frente de todos, declarando guerra ao todos os reinos e avisando para se preparem que voltaria para destruir todos os reinos um a um e saiu. A filha do rei e rainha que foram mortos pela Bruxa, a princesa Fiona, presenciou todo o assassinato e a declaração de guerra e se enfureceu...Você foi convocado para fazer parte do exercito que deseja derrotar a bruxa, você aceita o desafio? < S | N >");
-            scene1.addChoice("Sim, aceito a missão de matar a bruxa!", 2);
-            scene1.addChoice("Não, vai procurar o que fazer..", 9);
-            storyManager.addScene(1, scene1);
-    
-            Scene scene2(asciiArts["cavaleiro"], "Escolha sua classe:.");
-            scene2.addChoice("Cavaleiro", 3);
-            scene2.addChoice("Mago", 3);
-            storyManager.addScene(2, scene2);
-
-            Scene scene3(asciiArts["ogro"], "Cap I Parte - I: A floresta \n Ao entrar no exército você foi ao castelo da princesa fiona onde todos foram convocados para receber as primeiras instruções...Chegando no castelo, você estranhou, pois só tinha você, um (mago ou cavaleiro, a classe que restou) e um aldeão, e se questionou se estava no lugar certo, e logo em seguida a princesa foi até vocês e se pronunciou: \n-Olá bravos guerreiros, sinto dizer que só restou a nós, tínhamos um exército com mais de 10 mil homens mas todos foram mortos pela Bruxa na primeira tentativa de invasão, mas convoquei vocês aqui porque a morte desses homens não foi em vão, eles nos deixaram um pedaço de pergaminho com um mapa até a Bruxa e todos os possíveis perigos que nós iremos enfrentar.\nE logo o aldeão pergunta:\n -Nós? Você irá conosco? E seremos so nós?\n E a princesa responde:\n -Sim! Não perderei a oportunidade de vingar meus pais, além disso, durante toda minha vida fui treinada por uma feiticeira que aconselhava minha família, então poderei lutar ao lado de vocês.\nE respondendo a sua segunda pergunta, Sim! Seremos só nós, e será o suficiente para acabar com a Bruxa agora que temos esse pergaminho.-\nApós a pequena reunião e sanadas as dúvidas entre o grupo, o mesmo se dirige para floresta em busca do covil da bruxa e é surpreendido por um grupo de ogros atacando aldeões.\n[Missão 01] Derrote os ogros antes que eles matem os aldeões, PREPARE-SE PARA O COMBATE!");
-            scene3.addChoice("Iniciar o combate", 35);
-            storyManager.addScene(3, scene3);
-            
-            Scene scene35(asciiArts["demo"], "Vocês vencem os ogros após muito sacrifício, porém na busca pela bruxa vocês chegam ao labirinto e devem encontrar a entrada do covil, mas agora estão parados em uma bifurcação com 03 salas que não estavam registrados no mapa, qual deseja entrar?");
-            scene35.addChoice("Sala Clara", 36);
-            scene35.addChoice("Sala meio iluminada",4 );
-            scene35.addChoice("Sala Escura", 4);
-            storyManager.addScene(35, scene35);
-
-            Scene scene36(asciiArts["demo"], "Um demônio foi conjurado pegando vocês de surpresa, não há como vencer !");
-            scene36.addChoice("Enfrentar assim mesmo", 9);
-            scene36.addChoice("Fugir imediatamente",4 );
-            storyManager.addScene(36, scene36);
-
-            Scene scene4(asciiArts["bruxa"], "Cap II: A bruxa \n Após a batalha no labirinto, vocês andam por muitas horas em busca do covil, seguindo o mapa que vocês possuem, o cheiro de pântano começa a crescer, a umidade se tora desconfortável, uma névoa vem crescendo ha dias, de repente vocês saem do labirinto e se deparam com uma criatura na entrada de um covil, aparentemente realizando algum tipo de ritual, o que deseja fazer:");
-            scene4.addChoice("Aproximar-se sorrateiramente", 5);
-            scene4.addChoice("Atacar com tudo", 9);
-            storyManager.addScene(4, scene4);
-
-            Scene scene5(asciiArts["dragao"], "Cap III: A segunda forma \n Vocês lutaram bravamente e derrotaram a bruxa, mas as coisas não são tão fáceis quanto parece, quando olham para o corpo dela desfalecido no chão, percebem que a sua pele começa a mudar, olhos amarelando, dentes afiados e a seu tamanho aumentando, de repente, um dragão aparece.\n[Missão 02: Derrote o dragão]");
-            scene5.addChoice("Iniciar o combate", 6);
-            storyManager.addScene(5, scene5);
-    
-            Scene scene6(asciiArts["mago_ataque"], "Percebendo que a luta com o dragão estava bastante perigosa a princesa desperta um poder ancestral e canaliza toda a energia para destruir o dragão, salvando todos do grupo. O dragão se debate, gorgoleja e finalmente é derrotado..");
-            scene6.addChoice("Iniciar o combate:", 7);
-            storyManager.addScene(6, scene6);
-    
-            Scene scene7(asciiArts["castelo"], "Parabéns, com a derrota do dragão o reino provou uma paz por alguns anos ! ");
-            scene7.addChoice("Pressione para continuar", 8);
-            storyManager.addScene(7, scene7);
+            storyManager.attachFixed(HISTORIA_PADRAO.data(), HISTORIA_PADRAO.size());
+        }
 
-            Scene scene8(asciiArts["endgame"], "Porém tudo que é bom dura pouco, boatos surgem e parece que a bruxa deixou ovos de dragão escondidos na floresta, que eclodiram com o passar dos anos e agora relatos de diversos dragões atacando outros reinos tem se tornado frequentes, talvez ainda precisaremos da sua ajuda aventureiro.\n <<FIM>>");
-            scene8.addChoice("Voltar ao início", 1);
-            storyManager.addScene(8, scene8);
-    
-            Scene scene9(asciiArts["gameover"], "Você morreu. Deseja tentar de novo?");
-            scene9.addChoice("Sim", 1);
-            scene9.addChoice("Não", 2);
-            storyManager.addScene(9, scene9);
+        // Carrega a história compilada em "storyPath"; se o arquivo não puder ser usado, fica com a história padrão
+        explicit Game(const std::string &storyPath) {
+            if (!storyManager.loadCompiled(storyPath))
+                storyManager.attachFixed(HISTORIA_PADRAO.data(), HISTORIA_PADRAO.size());
         }
     
-        // Método principal do jogo, que gerencia o fluxo entre as cenas
+        // Método principal do jogo: conduz uma partida pela entrada padrão (terminal, arquivo ou pipe).
+        // Com setReplayPath, a partida é gravada para poder ser reproduzida depois (ver ReplayRunner)
         void run() {
-            int currentSceneId = 1;
+            ReplayLog log;
+            runSession(inputHandler, replayPath.empty() ? nullptr : &log);
+            if (!replayPath.empty())
+                log.save(replayPath);
+            TRACE_DUMP("jogo_trace.json");
+        }
+
+        // Joga em sequência as partidas de um roteiro (ver InputHandler: uma por trecho entre separadores),
+        // todas no mesmo processo e sobre a mesma história; retorna quantas partidas foram jogadas
+        size_t runScript(InputHandler &input) {
+            size_t partidas = 0;
+            do {
+                runSession(input, nullptr);
+                partidas++;
+            } while (input.nextSession());
+            return partidas;
+        }
+
+        // Fluxo de uma partida, que gerencia a passagem entre as cenas. O texto de cada turno é acumulado
+        // em "saida" e a corrotina fica suspensa esperando a escolha em "entrada", então o mesmo fluxo
+        // serve ao terminal (run), ao servidor de rede e a execuções com entradas roteirizadas.
+        // Com "log", a semente e cada escolha aplicada são gravadas para reprodução.
+        Tarefa<> play(CanalEntrada &entrada, std::string &saida, ReplayLog *log = nullptr) {
+            GameSession session;
+            uint64_t seed = Dados::sementeAleatoria();
+            storyManager.startSession(session, seed);
+            Metrics::count(Counter::Sessions);
+            if (log) {
+                log->begin(seed, storyManager.getGraph().getFingerprint());
+                log->recordState(session);
+            }
             while (true) {
-                Scene *currentScene = storyManager.getScene(currentSceneId);
-                if (currentScene == nullptr) {
-                    std::cout << "Cena não encontrada. Encerrando o jogo.\n";
-                    break;
+                uint32_t visible;
+                {
+                    TRACE_SCOPE("scene_lookup");
+                    if (!storyManager.hasScene(session.sceneId)) {
+                        saida += "Cena não encontrada. Encerrando o jogo.\n";
+                        co_return;
+                    }
+                    visible = storyManager.getVisibleChoices(session);
                 }
                 
-                // Exibe a cena atual
-                currentScene->display();
+                // Exibe a cena atual, só com as escolhas disponíveis para esta sessão
+                Metrics::visitScene(session.sceneId);
+                {
+                    TRACE_SCOPE("compose");
+                    if (!renderer.appendFrame(saida, storyManager.getGraph(), session.sceneId, visible))
+                        saida += "(A arte desta cena está corrompida e não pôde ser exibida.)\n";
+                }
                 
-                // Se a cena não tiver escolhas, finaliza o jogo
-                if (currentScene->getChoices().empty()) {
-                    std::cout << "\nFim da história.\n";
-                    break;
+                // Se a cena não tiver escolhas (ou nenhuma estiver disponível), finaliza o jogo
+                if (storyManager.getVisibleChoiceCount(session) == 0) {
+                    saida += "\nFim da história.\n";
+                    co_return;
                 }
                 
                 // Processa a escolha do usuário
-                int choice = inputHandler.getUserChoice();
-                if (choice <= 0 || choice > currentScene->getChoices().size()) {
-                    std::cout << "Opção inválida, tente novamente.\n";
+                saida += "\nDigite sua escolha: ";
+                auto pedido = std::chrono::steady_clock::now();
+                std::string texto = co_await entrada.linha();
+                Metrics::decision(session.sceneId, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - pedido).count()));
+                // "metricas" grava as métricas do processo (ver Metrics) em metricsPath
+                if (!metricsPath.empty() && texto == "metricas") {
+                    saida += Metrics::exportTo(metricsPath) ? "Métricas gravadas em " + metricsPath + ".\n" : "Não foi possível gravar as métricas.\n";
                     continue;
                 }
-                currentSceneId = currentScene->getChoices()[choice - 1].getTargetSceneId();
+                // "salvar" e "carregar" no lugar do número gravam ou retomam a partida em savePath
+                if (!savePath.empty() && (texto == "salvar" || texto == "carregar")) {
+                    if (texto == "salvar") {
+                        saida += saveToFile(session) ? "Partida salva.\n" : "Não foi possível salvar a partida.\n";
+                    } else if (loadFromFile(session)) {
+                        saida += "Partida carregada.\n";
+                        if (log) {
+                            log->recordRestore(session);
+                            log->recordState(session);
+                        }
+                    } else {
+                        saida += "Nenhuma partida salva desta história.\n";
+                    }
+                    continue;
+                }
+                TRACE_SCOPE("transition");
+                int choice = std::atoi(texto.c_str());
+                GameSession before = session;
+                if (!storyManager.applyChoice(session, choice)) {
+                    Metrics::count(Counter::InvalidChoices);
+                    saida += "Opção inválida, tente novamente.\n";
+                    continue;
+                }
+                Metrics::count(Counter::Choices);
+                if (log) {
+                    if (log->checkpointDue())
+                        log->addCheckpoint(before);
+                    log->record(static_cast<uint32_t>(choice));
+                    log->recordState(session);
+                }
             }
         }
+
+        // Executa uma partida sem terminal sobre o mesmo grafo de cenas do modo interativo
+        PlaythroughResult runHeadless(const std::vector<int> &choices) const {
+            return HeadlessRunner(storyManager).run(choices);
+        }
+
+        // Arquivo usado pelos comandos "salvar" e "carregar"; vazio desliga os comandos (ex.: no servidor)
+        void setSavePath(const std::string &path) { savePath = path; }
+
+        // Arquivo em que run() grava o registro da partida; vazio, o padrão, desliga a gravação
+        void setReplayPath(const std::string &path) { replayPath = path; }
+
+        // Arquivo do comando "metricas" (JSON se terminar em ".json", texto nos outros casos); vazio, o padrão,
+        // desliga o comando
+        void setMetricsPath(const std::string &path) { metricsPath = path; }
+
+        // Acesso ao grafo de cenas para execuções em lote (HeadlessRunner)
+        const StoryManager& getStoryManager() const { return storyManager; }
+
+        // Medições de bytes e tempo por quadro exibido
+        const FrameRenderer& getRenderer() const { return renderer; }
+
+        // Descritor em que os quadros são escritos (1 por padrão); negativo descarta a saída (roteiros em lote)
+        void setOutput(int fd) { renderer.setOutput(fd); }
     
     private:
+        // Conduz uma partida pelo fluxo de play(), com uma escrita por turno, até a história acabar ou a
+        // entrada da partida terminar (fim do arquivo ou do pipe, erro de leitura ou separador de roteiro) ou a
+        // saída falhar
+        void runSession(InputHandler &input, ReplayLog *log) {
+            CanalEntrada entrada;
+            std::string saida;
+            Tarefa<> fluxo = play(entrada, saida, log);
+            fluxo.iniciar();
+            while (true) {
+                {
+                    TRACE_SCOPE("display");
+                    if (!renderer.write(saida)) {
+                        // Sem como mostrar o jogo (terminal fechado, pipe sem leitor), a partida acaba aqui
+                        std::cerr << "Não foi possível escrever a saída do jogo: " << std::strerror(renderer.getError()) << "\n";
+                        break;
+                    }
+                }
+                saida.clear();
+                if (fluxo.concluida())
+                    break;
+                std::string token;
+                {
+                    TRACE_SCOPE("input_wait");
+                    if (!input.readToken(token))
+                        break;
+                }
+                entrada.fornecer(std::move(token));
+            }
+        }
+
+        bool saveToFile(const GameSession &session) const {
+            SessionSnapshot snapshot;
+            storyManager.saveSession(session, snapshot);
+            std::ofstream out(savePath, std::ios::binary);
+            out.write(reinterpret_cast<const char *>(snapshot.data()), static_cast<std::streamsize>(snapshot.size()));
+            return static_cast<bool>(out);
+        }
+
+        bool loadFromFile(GameSession &session) const {
+            SessionSnapshot snapshot;
+            std::ifstream in(savePath, std::ios::binary);
+            if (!in.read(reinterpret_cast<char *>(snapshot.data()), static_cast<std::streamsize>(snapshot.size())))
+                return false;
+            return storyManager.restoreSession(snapshot, session) == SessionSnapshot::Status::Ok;
+        }
+
         StoryManager storyManager;
         InputHandler inputHandler;
-        std::map<std::string, std::string> asciiArts; // Map de ASCII arts pré-definidas
+        FrameRenderer renderer;
+        std::string savePath = "jogo.sav";
+        std::string replayPath; // Desligado: gravar sempre sobrescreveria a gravação anterior sem aviso
+        std::string metricsPath; // Desligado: quem roda o jogo escolhe se e onde as métricas são gravadas
 };
     
 /*nas escolhas do jogador pode acontecer eventos aletorios que vao modificar seus 
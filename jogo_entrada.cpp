@@ -0,0 +1,227 @@
+#pragma once
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/*
+Função: Responsável por capturar e interpretar a entrada do usuário. Essa classe pode validar as opções digitadas ou selecionadas, transformando a entrada em comandos ou escolhas que serão processadas pelo StoryManager.
+NEW: A entrada vem de um terminal, de um arquivo, de um pipe ou de um roteiro em memória. O descritor é lido em blocos grandes (BLOCK_SIZE) e as palavras são separadas dentro do próprio bloco, sem passar pelo std::cin; em um pipe com milhares de escolhas isso são poucas leituras no lugar de uma por escolha.
+O fim da entrada e os erros de leitura encerram a sessão (readToken retorna false e getStatus diz o motivo) em vez de virarem escolhas inválidas repetidas. Em roteiros, uma linha com SESSION_SEPARATOR ("---") termina uma partida e começa a próxima, então um único processo pode conduzir muitas partidas gravadas (ver Game::runScript):
+
+    1 2 1
+    ---
+    2 salvar 1
+*/
+class InputHandler {
+    public:
+        enum class Status {
+            Ok,
+            EndOfSession, // SESSION_SEPARATOR: a partida terminou, mas a entrada continua (nextSession)
+            EndOfInput,   // Fim do arquivo, do pipe ou do roteiro
+            Error         // Erro de leitura (getError tem o errno)
+        };
+
+        static constexpr std::string_view SESSION_SEPARATOR = "---";
+        static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+        // Entrada padrão, seja ela um terminal, um arquivo redirecionado ou um pipe
+        InputHandler() : fd(0) {}
+        explicit InputHandler(int fd) : fd(fd) {}
+
+        InputHandler(const InputHandler &) = delete;
+        InputHandler &operator=(const InputHandler &) = delete;
+
+        ~InputHandler() { closeOwned(); }
+
+        // Lê do arquivo (ou pipe nomeado) "path"; false se ele não puder ser aberto
+        bool open(const std::string &path) {
+#ifdef _WIN32
+            int novo = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+            int novo = ::open(path.c_str(), O_RDONLY);
+#endif
+            if (novo < 0) {
+                error = errno;
+                return false;
+            }
+            reset(novo);
+            owned = true;
+            return true;
+        }
+
+        // Lê as palavras de um roteiro em memória em vez de um descritor
+        void setScript(std::string script) {
+            reset(-1);
+            buffer = std::move(script);
+            end = buffer.size();
+            eof = true;
+        }
+
+        /* Próxima palavra, como uma visão do buffer interno válida até a próxima leitura. Retorna false
+        no fim da partida (SESSION_SEPARATOR), no fim da entrada ou em um erro de leitura; nos dois últimos
+        casos as chamadas seguintes continuam retornando false. */
+        bool next(std::string_view &token) {
+            if (status != Status::Ok)
+                return false;
+            while (true) {
+                while (pos < end && isSpace(buffer[pos]))
+                    pos++;
+                size_t inicio = pos;
+                while (pos < end && !isSpace(buffer[pos]))
+                    pos++;
+                // Uma palavra só está completa se terminou em um espaço ou se não há mais nada para ler
+                if (pos > inicio && (pos < end || eof)) {
+                    token = std::string_view(buffer).substr(inicio, pos - inicio);
+                    if (token == SESSION_SEPARATOR) {
+                        status = Status::EndOfSession;
+                        return false;
+                    }
+                    return true;
+                }
+                if (eof) {
+                    status = Status::EndOfInput;
+                    return false;
+                }
+                pos = inicio;
+                if (!fill()) {
+                    status = error ? Status::Error : Status::EndOfInput;
+                    if (status == Status::EndOfInput && pos < end)
+                        continue; // Última palavra, sem espaço depois dela
+                    return false;
+                }
+            }
+        }
+
+        // Lê a próxima palavra digitada; retorna false no fim da partida ou da entrada
+        bool readToken(std::string &token) {
+            std::string_view palavra;
+            if (!next(palavra))
+                return false;
+            token.assign(palavra);
+            return true;
+        }
+
+        // Pede e lê uma escolha numérica. Texto que não é número vira 0 (escolha inválida, que o chamador
+        // recusa); retorna false no fim da partida ou da entrada, em vez de repetir a última escolha
+        bool getUserChoice(int &choice) {
+            std::cout << "\nDigite sua escolha: ";
+            std::string_view palavra;
+            if (!next(palavra))
+                return false;
+            choice = 0;
+            for (char c : palavra) {
+                if (c < '0' || c > '9' || choice > 100000000) {
+                    choice = 0;
+                    break;
+                }
+                choice = choice * 10 + (c - '0');
+            }
+            return true;
+        }
+
+        // Descarta o resto da partida atual (até o próximo SESSION_SEPARATOR)
+        void skipSession() {
+            std::string_view palavra;
+            while (next(palavra)) {
+            }
+        }
+
+        // Passa para a próxima partida do roteiro; false se a entrada acabou (mesmo que depois de um último separador)
+        bool nextSession() {
+            if (status == Status::Ok)
+                skipSession();
+            if (status != Status::EndOfSession)
+                return false;
+            status = Status::Ok;
+            return !atEnd();
+        }
+
+        Status getStatus() const { return status; }
+        int getError() const { return error; }
+
+    private:
+        static bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\v'; }
+
+        // Só há espaços até o fim da entrada
+        bool atEnd() {
+            while (true) {
+                while (pos < end && isSpace(buffer[pos]))
+                    pos++;
+                if (pos < end)
+                    return false;
+                if (eof || !fill()) {
+                    status = error ? Status::Error : Status::EndOfInput;
+                    return true;
+                }
+            }
+        }
+
+        void reset(int novo) {
+            closeOwned();
+            fd = novo;
+            buffer.clear();
+            pos = end = 0;
+            eof = false;
+            error = 0;
+            status = Status::Ok;
+        }
+
+        void closeOwned() {
+            if (owned && fd >= 0) {
+#ifdef _WIN32
+                _close(fd);
+#else
+                ::close(fd);
+#endif
+            }
+            owned = false;
+        }
+
+        // Move a palavra incompleta para o começo e lê o próximo bloco depois dela; false no fim ou em erro
+        bool fill() {
+            if (fd < 0) {
+                eof = true;
+                return false;
+            }
+            std::memmove(&buffer[0], buffer.data() + pos, end - pos);
+            end -= pos;
+            pos = 0;
+            if (buffer.size() < end + BLOCK_SIZE)
+                buffer.resize(end + BLOCK_SIZE);
+            while (true) {
+#ifdef _WIN32
+                int lidos = _read(fd, &buffer[end], static_cast<unsigned int>(buffer.size() - end));
+#else
+                ssize_t lidos = ::read(fd, &buffer[end], buffer.size() - end);
+#endif
+                if (lidos > 0) {
+                    end += static_cast<size_t>(lidos);
+                    return true;
+                }
+                if (lidos < 0 && errno == EINTR)
+                    continue;
+                if (lidos < 0)
+                    error = errno;
+                eof = true;
+                return false;
+            }
+        }
+
+        int fd;
+        bool owned = false;
+        std::string buffer;
+        size_t pos = 0;
+        size_t end = 0; // Bytes válidos em buffer
+        bool eof = false;
+        int error = 0;
+        Status status = Status::Ok;
+};
@@ -0,0 +1,563 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "jogo_compressao.cpp"
+#include "jogo_decisoes.cpp"
+#include "jogo_mapeamento.cpp"
+
+/*
+Formato binário da história (.bin)
+Gerado pelo jogo_compilador a partir do formato de texto e lido pelo StoryManager sem nenhuma interpretação: o arquivo é mapeado em memória e as tabelas são usadas diretamente.
+
+    StoryFileHeader
+    StorySceneRecord[sceneSlots]   tabela densa indexada pelo id da cena
+    StoryChoiceRecord[choiceCount] todas as escolhas em sequência; cada cena aponta para sua faixa
+    char[stringPoolSize]           textos (artes, narrativas, escolhas) sem terminador e bytecode das condições e efeitos
+                                   (ver jogo_decisoes.cpp); cada texto ou programa distinto aparece uma única vez
+
+Todos os campos são inteiros de 32 bits little-endian e as seções começam em offsets múltiplos de 4.
+O cabeçalho guarda a identificação do conteúdo (contentHash): o FNV-1a de 32 bits da imagem inteira, com o próprio campo valendo 0. Ela é calculada por quem gera a imagem, então carregar não precisa percorrer o arquivo; qualquer mudança de texto, alvo, condição ou efeito a altera.
+*/
+struct StoryFileHeader {
+    char magic[4];             // "HIST"
+    uint32_t version;
+    int32_t startSceneId;
+    uint32_t sceneSlots;       // Maior id + 1
+    uint32_t choiceCount;
+    uint32_t stringPoolSize;
+    uint32_t scenesOffset;
+    uint32_t choicesOffset;
+    uint32_t stringPoolOffset;
+    uint32_t contentHash;      // A partir da versão 4
+};
+
+struct StorySceneRecord {
+    uint32_t flags;            // SCENE_EXISTS quando o id está em uso, SCENE_ENDING nos finais da história,
+                               // SCENE_CONDITIONAL quando alguma escolha tem condição
+    uint32_t artOffset;
+    uint32_t artLength;
+    uint32_t narrativeOffset;
+    uint32_t narrativeLength;
+    uint32_t firstChoice;
+    uint32_t choiceCount;
+};
+
+struct StoryChoiceRecord {
+    uint32_t textOffset;
+    uint32_t textLength;
+    int32_t targetSceneId;
+    uint32_t conditionOffset;  // Bytecode no pool, ou DECISION_NO_CODE se a escolha está sempre disponível
+    uint32_t effectOffset;     // Bytecode no pool, ou DECISION_NO_CODE se a escolha não tem efeitos
+};
+
+constexpr char STORY_MAGIC[4] = {'H', 'I', 'S', 'T'};
+constexpr uint32_t STORY_VERSION = 4;
+constexpr size_t STORY_HEADER_V3_SIZE = 36; // Cabeçalho das versões 2 e 3, sem contentHash
+constexpr uint32_t SCENE_EXISTS = 1;
+constexpr uint32_t SCENE_ENDING = 2;
+constexpr uint32_t SCENE_CONDITIONAL = 4;
+constexpr uint32_t SCENE_ART_PACKED = 8; // A arte está no pool comprimida por ArtCodec
+constexpr int MAX_CONDITIONAL_CHOICES = 32; // As escolhas visíveis de uma cena cabem em uma máscara de 32 bits
+
+// FNV-1a de 32 bits do contentHash; constexpr para a imagem das histórias em tabelas constexpr
+struct StoryHash {
+    uint32_t value = 2166136261u;
+
+    constexpr void add(uint8_t byte) { value = (value ^ byte) * 16777619u; }
+    constexpr void addWord(uint32_t word) {
+        for (int i = 0; i < 4; i++)
+            add(static_cast<uint8_t>(word >> (8 * i)));
+    }
+
+    // Imagem já montada na memória; os bytes do contentHash (se houver) contam como 0
+    static uint32_t ofImage(const char *base, size_t size, bool hasContentHash) {
+        constexpr size_t field = offsetof(StoryFileHeader, contentHash);
+        StoryHash hash;
+        for (size_t i = 0; i < size; i++)
+            hash.add(hasContentHash && i >= field && i < field + 4 ? 0 : static_cast<uint8_t>(base[i]));
+        return hash.value;
+    }
+};
+
+/*
+StoryGraph
+Função: Grafo de cenas em formato compacto (CSR): as cenas ficam em uma tabela densa indexada pelo id, todas as escolhas em um único vetor de arestas e cada cena guarda o início e a quantidade das suas. Os textos são devolvidos como std::string_view para o pool, sem cópias.
+As tabelas podem vir de um arquivo compilado mapeado em memória (load) ou de um bloco montado na memória pelo StoryManager (adopt); nos dois casos as consultas são acessos diretos, sem alocações, e o custo de carregar não depende do tamanho da história.
+Como o arquivo pode estar corrompido, os registros são conferidos, mas nunca todos de uma vez: na carga só o cabeçalho e os limites das seções (custo fixo, sem tocar as páginas das tabelas); hasScene confere o registro da cena (textos dentro do pool, faixa de escolhas dentro da tabela) e checkScene, chamado por quem vai jogar a cena, confere o tamanho declarado da arte comprimida e as escolhas dela (textos e bytecode por verifyDecisionCode). Uma arte comprimida corrompida só é percebida ao ser descomprimida para exibição, e appendArt a informa. As demais consultas só valem para cenas já conferidas e não conferem nada. Alvos de escolhas que não existem são permitidos: o StoryAnalysis os aponta e o jogo os recusa ao jogar.
+*/
+class StoryGraph {
+    public:
+        StoryGraph() {}
+        StoryGraph(const StoryGraph &) = delete;
+        StoryGraph &operator=(const StoryGraph &) = delete;
+
+        // Mapeia o arquivo e passa a usar suas tabelas
+        bool load(const std::string &path) {
+            unload();
+            if (!file.open(path))
+                return false;
+            if (!attach(file.data(), file.size())) {
+                file.close();
+                return false;
+            }
+            return true;
+        }
+
+        // Usa tabelas já presentes na memória (o bloco precisa continuar válido enquanto a visão existir)
+        bool attach(const void *data, size_t size) {
+            header = nullptr;
+            const char *base = static_cast<const char *>(data);
+            if (size < STORY_HEADER_V3_SIZE || reinterpret_cast<uintptr_t>(base) % 4 != 0)
+                return false;
+            const StoryFileHeader *h = reinterpret_cast<const StoryFileHeader *>(base);
+            // A versão 3 é a 4 sem contentHash e a 2 é a 3 sem artes comprimidas, então os arquivos antigos continuam valendo
+            if (std::memcmp(h->magic, STORY_MAGIC, 4) != 0 || h->version < 2 || h->version > STORY_VERSION)
+                return false;
+            if (h->version >= 4 && size < sizeof(StoryFileHeader))
+                return false;
+            if (!sectionFits(h->scenesOffset, uint64_t(h->sceneSlots) * sizeof(StorySceneRecord), size) ||
+                !sectionFits(h->choicesOffset, uint64_t(h->choiceCount) * sizeof(StoryChoiceRecord), size) ||
+                !sectionFits(h->stringPoolOffset, h->stringPoolSize, size))
+                return false;
+            // Só os arquivos antigos, sem a identificação gravada, são percorridos para calculá-la
+            fingerprint = h->version >= 4 ? h->contentHash : StoryHash::ofImage(base, size, false);
+            header = h;
+            scenes = reinterpret_cast<const StorySceneRecord *>(base + h->scenesOffset);
+            choices = reinterpret_cast<const StoryChoiceRecord *>(base + h->choicesOffset);
+            pool = base + h->stringPoolOffset;
+            return true;
+        }
+
+        // Passa a usar (e guardar) um bloco gerado por StoryCompiler::build
+        bool adopt(std::vector<char> &&bytes) {
+            unload();
+            owned = std::move(bytes);
+            if (!attach(owned.data(), owned.size())) {
+                owned.clear();
+                return false;
+            }
+            return true;
+        }
+
+        void unload() {
+            header = nullptr;
+            file.close();
+            owned.clear();
+        }
+
+        bool isLoaded() const { return header != nullptr; }
+        int getStartSceneId() const { return header ? header->startSceneId : 1; }
+        int getSceneSlots() const { return header ? static_cast<int>(header->sceneSlots) : 0; }
+
+        // Identificação do conteúdo da história (contentHash), usada para recusar sessões salvas e
+        // registros de partidas gravados em outra história, mesmo que ela tenha o mesmo tamanho
+        uint32_t getFingerprint() const { return header ? fingerprint : 0; }
+
+        // A cena existe e o registro dela cabe nas tabelas: textos dentro do pool e faixa de escolhas dentro da tabela
+        bool hasScene(int id) const {
+            if (id < 0 || id >= getSceneSlots())
+                return false;
+            const StorySceneRecord &r = scenes[id];
+            return (r.flags & SCENE_EXISTS) && textFits(r.artOffset, r.artLength) && textFits(r.narrativeOffset, r.narrativeLength) &&
+                   uint64_t(r.firstChoice) + r.choiceCount <= header->choiceCount;
+        }
+
+        // hasScene, o tamanho declarado da arte comprimida e as escolhas da cena: textos dentro do pool e bytecode das
+        // condições e efeitos, que o jogo executa. Custa o número de escolhas da cena e fica para quem vai jogá-la
+        // (StoryManager::hasScene), não para a carga. A arte só é descomprimida ao ser exibida (appendArt)
+        bool checkScene(int id) const {
+            if (!hasScene(id))
+                return false;
+            const StorySceneRecord &r = scenes[id];
+            if (isArtPacked(id) && !ArtCodec::hasValidSize(getArt(id)))
+                return false;
+            for (uint32_t i = r.firstChoice; i < r.firstChoice + r.choiceCount; i++) {
+                const StoryChoiceRecord &c = choices[i];
+                if (!textFits(c.textOffset, c.textLength) || !codeFits(c.conditionOffset, true) || !codeFits(c.effectOffset, false))
+                    return false;
+            }
+            return true;
+        }
+        // Arte como está no pool: comprimida quando isArtPacked (use appendArt para o texto)
+        std::string_view getArt(int id) const { return text(scenes[id].artOffset, scenes[id].artLength); }
+        bool isArtPacked(int id) const { return (scenes[id].flags & SCENE_ART_PACKED) != 0; }
+
+        // Acrescenta o texto da arte ao fim de "out", descomprimindo-a direto ali se preciso. Se uma arte comprimida
+        // estiver corrompida, "out" volta ao que era e o retorno é false
+        bool appendArt(int id, std::string &out) const {
+            if (!isArtPacked(id)) {
+                out.append(getArt(id));
+                return true;
+            }
+            size_t before = out.size();
+            if (ArtCodec::appendDecoded(out, getArt(id)))
+                return true;
+            out.resize(before);
+            return false;
+        }
+
+        // Tamanho do texto da arte (descomprimido)
+        size_t getArtSize(int id) const { return isArtPacked(id) ? ArtCodec::decodedSize(getArt(id)) : scenes[id].artLength; }
+        std::string_view getNarrative(int id) const { return text(scenes[id].narrativeOffset, scenes[id].narrativeLength); }
+        int getChoiceCount(int id) const { return static_cast<int>(scenes[id].choiceCount); }
+
+        // Cena final: marcada com ::final (mesmo que ofereça "jogar de novo") ou sem escolhas
+        bool isEnding(int id) const { return (scenes[id].flags & SCENE_ENDING) || scenes[id].choiceCount == 0; }
+
+        std::string_view getChoiceText(int id, int index) const {
+            const StoryChoiceRecord &c = choices[scenes[id].firstChoice + index];
+            return text(c.textOffset, c.textLength);
+        }
+        int getChoiceTarget(int id, int index) const { return choices[scenes[id].firstChoice + index].targetSceneId; }
+
+        // Alguma escolha da cena depende do estado da sessão
+        bool isConditional(int id) const { return (scenes[id].flags & SCENE_CONDITIONAL) != 0; }
+
+        // Bytecode da condição / dos efeitos da escolha; nullptr se ela não tiver
+        const uint8_t *getChoiceCondition(int id, int index) const { return code(choices[scenes[id].firstChoice + index].conditionOffset); }
+        const uint8_t *getChoiceEffect(int id, int index) const { return code(choices[scenes[id].firstChoice + index].effectOffset); }
+
+        // Acesso direto às arestas, para análises que percorrem o grafo inteiro
+        int getEdgeCount() const { return static_cast<int>(header->choiceCount); }
+        int getFirstChoice(int id) const { return static_cast<int>(scenes[id].firstChoice); }
+        int getEdgeTarget(int edge) const { return choices[edge].targetSceneId; }
+
+    private:
+        bool textFits(uint32_t offset, uint32_t length) const { return uint64_t(offset) + length <= header->stringPoolSize; }
+        bool codeFits(uint32_t offset, bool condition) const {
+            return offset == DECISION_NO_CODE ||
+                   (offset < header->stringPoolSize &&
+                    verifyDecisionCode(reinterpret_cast<const uint8_t *>(pool + offset), header->stringPoolSize - offset, condition));
+        }
+
+        static bool sectionFits(uint32_t offset, uint64_t length, size_t size) {
+            return offset % 4 == 0 && uint64_t(offset) + length <= size;
+        }
+        std::string_view text(uint32_t offset, uint32_t length) const { return std::string_view(pool + offset, length); }
+        const uint8_t *code(uint32_t offset) const {
+            return offset == DECISION_NO_CODE ? nullptr : reinterpret_cast<const uint8_t *>(pool + offset);
+        }
+
+        MappedFile file;
+        std::vector<char> owned;
+        const StoryFileHeader *header = nullptr;
+        const StorySceneRecord *scenes = nullptr;
+        const StoryChoiceRecord *choices = nullptr;
+        const char *pool = nullptr;
+        uint32_t fingerprint = 0;
+};
+
+/*
+StoryCompiler
+Função: Monta o formato binário a partir de cenas adicionadas por código ou lidas do formato de texto de autoria:
+
+    # comentário (fora dos blocos)
+    ::inicio 1
+    ::arte <nome>
+    <linhas da arte, copiadas literalmente>
+    ::fim
+    ::cena <id> <nome da arte>
+    <linhas da narrativa>
+    ::final                              (opcional: a cena é um final da história)
+    ::escolha <id da cena alvo> <descrição>
+    ::se <condição>                      (opcional: a escolha anterior só aparece se a condição valer)
+    ::efeito <efeitos>                   (opcional: aplicados quando a escolha anterior é feita)
+    ::fim
+
+Condições e efeitos usam a linguagem de jogo_decisoes.cpp, por exemplo "::se forca >= 50 e nao mago" e
+"::efeito mago, ouro += 10" (historia_decisoes.txt é um exemplo completo).
+
+Textos iguais (por exemplo, a mesma arte usada em várias cenas) são gravados uma única vez.
+*/
+class StoryCompiler {
+    public:
+        void setStartScene(int id) { startSceneId = id; }
+
+        void addArt(const std::string &name, const std::string &text) { arts[name] = text; }
+
+        // Adiciona uma cena; "art" é o texto da arte (não o nome). Retorna false se o id for inválido ou repetido
+        bool addScene(int id, std::string_view art, std::string_view narrative) {
+            if (id < 0 || sceneIndex.count(id))
+                return false;
+            sceneIndex[id] = scenes.size();
+            scenes.push_back({id, std::string(art), std::string(narrative), false, {}});
+            return true;
+        }
+
+        // Marca a última cena adicionada como um final da história
+        void markEnding() { scenes.back().ending = true; }
+
+        // Adiciona uma escolha à última cena adicionada
+        void addChoice(std::string_view text, int targetSceneId) {
+            scenes.back().choices.push_back({std::string(text), targetSceneId, std::string(), std::string()});
+        }
+
+        // Condição e efeitos da última escolha adicionada; retornam false (com o motivo em "error") se o texto não compilar
+        bool setChoiceCondition(std::string_view condition, std::string &error) {
+            if (scenes.back().choices.size() > static_cast<size_t>(MAX_CONDITIONAL_CHOICES)) {
+                error = "só as primeiras " + std::to_string(MAX_CONDITIONAL_CHOICES) + " escolhas de uma cena podem ter condição";
+                return false;
+            }
+            if (!checkCode(condition, true, error))
+                return false;
+            scenes.back().choices.back().condition = std::string(condition);
+            return true;
+        }
+        bool setChoiceEffect(std::string_view effect, std::string &error) {
+            if (!checkCode(effect, false, error))
+                return false;
+            scenes.back().choices.back().effect = std::string(effect);
+            return true;
+        }
+
+        // Lê o formato de texto; em caso de erro, "error" recebe a linha e o motivo
+        bool parse(std::istream &in, std::string &error) {
+            std::string line, body, name;
+            enum { Fora, Arte, Cena, Escolhas } estado = Fora;
+            int numero = 0;
+            bool primeira = true;
+            auto falha = [&](const std::string &motivo) {
+                error = "linha " + std::to_string(numero) + ": " + motivo;
+                return false;
+            };
+            while (std::getline(in, line)) {
+                numero++;
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                bool diretiva = line.compare(0, 2, "::") == 0;
+                if (estado == Fora) {
+                    if (line.empty() || line[0] == '#')
+                        continue;
+                    if (!diretiva)
+                        return falha("texto fora de um bloco ::arte ou ::cena");
+                    std::string comando, resto;
+                    splitDirective(line, comando, resto);
+                    if (comando == "inicio") {
+                        startSceneId = std::atoi(resto.c_str());
+                    } else if (comando == "arte") {
+                        if (resto.empty())
+                            return falha("::arte sem nome");
+                        name = resto;
+                        estado = Arte;
+                    } else if (comando == "cena") {
+                        std::string idTexto, arte;
+                        splitWord(resto, idTexto, arte);
+                        auto it = arts.find(arte);
+                        if (it == arts.end())
+                            return falha("arte desconhecida '" + arte + "'");
+                        if (!addScene(std::atoi(idTexto.c_str()), it->second, ""))
+                            return falha("id de cena inválido ou repetido '" + idTexto + "'");
+                        estado = Cena;
+                    } else {
+                        return falha("diretiva desconhecida '::" + comando + "'");
+                    }
+                    body.clear();
+                    primeira = true;
+                    continue;
+                }
+                if (diretiva) {
+                    std::string comando, resto;
+                    splitDirective(line, comando, resto);
+                    if (comando == "fim") {
+                        if (estado == Arte)
+                            addArt(name, body);
+                        else if (estado == Cena)
+                            scenes.back().narrative = body;
+                        estado = Fora;
+                        continue;
+                    }
+                    if (comando == "final" && estado == Cena) {
+                        scenes.back().narrative = body;
+                        markEnding();
+                        estado = Escolhas;
+                        continue;
+                    }
+                    if ((comando == "se" || comando == "efeito") && estado == Escolhas && !scenes.back().choices.empty()) {
+                        std::string motivo;
+                        bool ok = comando == "se" ? setChoiceCondition(resto, motivo) : setChoiceEffect(resto, motivo);
+                        if (!ok)
+                            return falha("'::" + comando + " " + resto + "': " + motivo);
+                        continue;
+                    }
+                    if (comando == "escolha" && estado != Arte) {
+                        if (estado == Cena)
+                            scenes.back().narrative = body;
+                        std::string alvo, texto;
+                        splitWord(resto, alvo, texto);
+                        addChoice(texto, std::atoi(alvo.c_str()));
+                        estado = Escolhas;
+                        continue;
+                    }
+                    return falha("diretiva inesperada '::" + comando + "'");
+                }
+                if (estado == Escolhas)
+                    return falha("texto depois das escolhas da cena");
+                if (!primeira)
+                    body += '\n';
+                body += line;
+                primeira = false;
+            }
+            if (estado != Fora)
+                return falha("bloco sem ::fim");
+            return true;
+        }
+
+        // Gera o conteúdo do arquivo binário
+        std::vector<char> build() const {
+            int maxId = -1;
+            size_t totalChoices = 0;
+            for (const SceneSource &s : scenes) {
+                if (s.id > maxId)
+                    maxId = s.id;
+                totalChoices += s.choices.size();
+            }
+
+            std::string pool;
+            std::unordered_map<std::string, uint32_t> interned;
+            auto intern = [&](const std::string &text) {
+                auto it = interned.find(text);
+                if (it != interned.end())
+                    return it->second;
+                uint32_t offset = static_cast<uint32_t>(pool.size());
+                pool += text;
+                interned.emplace(text, offset);
+                return offset;
+            };
+
+            // Os marcadores são numerados na ordem em que aparecem, cena por cena (a mesma de compileFixedStory)
+            DecisionSymbols symbols;
+            auto internCode = [&](const std::string &source, bool condition) {
+                if (source.empty())
+                    return DECISION_NO_CODE;
+                DecisionCode code = condition ? DecisionCompiler::compileCondition(source, symbols)
+                                              : DecisionCompiler::compileEffect(source, symbols);
+                return intern(std::string(reinterpret_cast<const char *>(code.bytes), code.size));
+            };
+
+            std::vector<StorySceneRecord> sceneTable(maxId + 1);
+            std::vector<StoryChoiceRecord> choiceTable;
+            choiceTable.reserve(totalChoices);
+            for (int id = 0; id <= maxId; id++) {
+                auto it = sceneIndex.find(id);
+                if (it == sceneIndex.end())
+                    continue;
+                const SceneSource &s = scenes[it->second];
+                StorySceneRecord &r = sceneTable[id];
+                r.flags = SCENE_EXISTS | (s.ending ? SCENE_ENDING : 0);
+                // A arte vai comprimida quando isso a deixa menor (as muito curtas ficam como estão)
+                std::string packed = s.art.size() <= ArtCodec::MAX_DECODED ? ArtCodec::compress(s.art) : s.art;
+                const std::string &art = packed.size() < s.art.size() ? packed : s.art;
+                if (&art == &packed)
+                    r.flags |= SCENE_ART_PACKED;
+                r.artOffset = intern(art);
+                r.artLength = static_cast<uint32_t>(art.size());
+                r.narrativeOffset = intern(s.narrative);
+                r.narrativeLength = static_cast<uint32_t>(s.narrative.size());
+                r.firstChoice = static_cast<uint32_t>(choiceTable.size());
+                r.choiceCount = static_cast<uint32_t>(s.choices.size());
+                for (const ChoiceSource &c : s.choices) {
+                    uint32_t textOffset = intern(c.text);
+                    uint32_t conditionOffset = internCode(c.condition, true);
+                    uint32_t effectOffset = internCode(c.effect, false);
+                    choiceTable.push_back({textOffset, static_cast<uint32_t>(c.text.size()), c.targetSceneId, conditionOffset, effectOffset});
+                    if (!c.condition.empty())
+                        r.flags |= SCENE_CONDITIONAL;
+                }
+            }
+
+            StoryFileHeader h;
+            std::memcpy(h.magic, STORY_MAGIC, 4);
+            h.version = STORY_VERSION;
+            h.startSceneId = startSceneId;
+            h.sceneSlots = static_cast<uint32_t>(sceneTable.size());
+            h.choiceCount = static_cast<uint32_t>(choiceTable.size());
+            h.stringPoolSize = static_cast<uint32_t>(pool.size());
+            h.scenesOffset = sizeof(StoryFileHeader);
+            h.choicesOffset = h.scenesOffset + h.sceneSlots * sizeof(StorySceneRecord);
+            h.stringPoolOffset = h.choicesOffset + h.choiceCount * sizeof(StoryChoiceRecord);
+            h.contentHash = 0;
+
+            std::vector<char> bytes(h.stringPoolOffset + pool.size());
+            std::memcpy(bytes.data(), &h, sizeof(h));
+            if (!sceneTable.empty())
+                std::memcpy(bytes.data() + h.scenesOffset, sceneTable.data(), sceneTable.size() * sizeof(StorySceneRecord));
+            if (!choiceTable.empty())
+                std::memcpy(bytes.data() + h.choicesOffset, choiceTable.data(), choiceTable.size() * sizeof(StoryChoiceRecord));
+            if (!pool.empty())
+                std::memcpy(bytes.data() + h.stringPoolOffset, pool.data(), pool.size());
+            h.contentHash = StoryHash::ofImage(bytes.data(), bytes.size(), true);
+            std::memcpy(bytes.data(), &h, sizeof(h));
+            return bytes;
+        }
+
+        bool writeFile(const std::string &path) const {
+            std::vector<char> bytes = build();
+            std::ofstream out(path, std::ios::binary);
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            return static_cast<bool>(out);
+        }
+
+        size_t getSceneCount() const { return scenes.size(); }
+
+    private:
+        struct ChoiceSource {
+            std::string text;
+            int targetSceneId;
+            std::string condition;
+            std::string effect;
+        };
+        struct SceneSource {
+            int id;
+            std::string art;
+            std::string narrative;
+            bool ending;
+            std::vector<ChoiceSource> choices;
+        };
+
+        // "::cena 1 intro" -> comando "cena", resto "1 intro"
+        static void splitDirective(const std::string &line, std::string &comando, std::string &resto) {
+            splitWord(line.substr(2), comando, resto);
+        }
+        // Compila só para conferir o texto; os nomes de marcadores novos entram na contagem da história
+        bool checkCode(std::string_view source, bool condition, std::string &error) {
+            DecisionSymbols local;
+            DecisionCode code = condition ? DecisionCompiler::compileCondition(source, local)
+                                          : DecisionCompiler::compileEffect(source, local);
+            if (!code.ok()) {
+                error = code.error;
+                return false;
+            }
+            for (int i = 0; i < local.flagCount; i++) {
+                std::string name(local.flags[i]);
+                if (std::find(flagNames.begin(), flagNames.end(), name) == flagNames.end())
+                    flagNames.push_back(name);
+            }
+            if (flagNames.size() > static_cast<size_t>(WORLD_FLAGS)) {
+                error = "a história usa mais de " + std::to_string(WORLD_FLAGS) + " marcadores";
+                return false;
+            }
+            return true;
+        }
+
+        static void splitWord(const std::string &text, std::string &first, std::string &rest) {
+            size_t space = text.find(' ');
+            first = text.substr(0, space);
+            rest = space == std::string::npos ? "" : text.substr(space + 1);
+        }
+
+        int startSceneId = 1;
+        std::unordered_map<std::string, std::string> arts;
+        std::vector<SceneSource> scenes;
+        std::unordered_map<int, size_t> sceneIndex;
+        std::vector<std::string> flagNames;
+};
@@ -0,0 +1,326 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+#include "jogo_historia.cpp"
+
+/*
+História em tabelas constexpr
+Função: Permite escrever a história em tabelas constantes (artes, cenas e escolhas) que o compilador confere e converte, durante a compilação, na mesma imagem binária que o StoryCompiler gera. O jogo só aponta um StoryGraph para essa imagem, então montar a história não custa nada em tempo de execução e não usa o heap.
+As funções de validação abaixo são usadas em static_assert por quem define a história, transformando cenas inexistentes e ids repetidos em erros de compilação:
+
+    static_assert(fixedSceneIdsAreDense(CENAS), "...");
+    static_assert(fixedChoiceTargetsExist(CENAS, ESCOLHAS), "...");
+    static_assert(fixedChoiceCodeIsValid(CENAS, ESCOLHAS), "...");
+
+As artes são comprimidas por ArtCodec também durante a compilação (packFixedArts), como o jogo_compilador faz com o formato de texto, então a imagem embutida tem o mesmo tamanho de um historia.bin.
+*/
+
+struct FixedArt {
+    std::string_view name;
+    std::string_view text;
+};
+
+// Cenas em ordem de id, começando em 1 (o id 0 fica livre, como nas histórias compiladas)
+struct FixedScene {
+    int id;
+    std::string_view art; // Nome de uma FixedArt
+    std::string_view narrative;
+    bool ending = false;
+};
+
+// Escolhas agrupadas pela cena de origem, na mesma ordem das cenas. Condição e efeitos são opcionais e
+// usam a linguagem de jogo_decisoes.cpp
+struct FixedChoice {
+    int sceneId;
+    std::string_view text;
+    int targetSceneId;
+    std::string_view condition = {};
+    std::string_view effect = {};
+};
+
+// Ids 1, 2, ..., N na ordem da tabela: densos e, portanto, únicos
+template <size_t S>
+constexpr bool fixedSceneIdsAreDense(const FixedScene (&scenes)[S]) {
+    for (size_t i = 0; i < S; i++)
+        if (scenes[i].id != static_cast<int>(i) + 1)
+            return false;
+    return true;
+}
+
+template <size_t S, size_t C>
+constexpr bool fixedChoiceTargetsExist(const FixedScene (&)[S], const FixedChoice (&choices)[C]) {
+    for (const FixedChoice &c : choices)
+        if (c.targetSceneId < 1 || c.targetSceneId > static_cast<int>(S))
+            return false;
+    return true;
+}
+
+// Cada escolha pertence a uma cena existente e as escolhas de uma cena estão juntas
+template <size_t S, size_t C>
+constexpr bool fixedChoicesAreGrouped(const FixedScene (&)[S], const FixedChoice (&choices)[C]) {
+    for (size_t i = 0; i < C; i++) {
+        if (choices[i].sceneId < 1 || choices[i].sceneId > static_cast<int>(S))
+            return false;
+        if (i > 0 && choices[i].sceneId < choices[i - 1].sceneId)
+            return false;
+    }
+    return true;
+}
+
+template <size_t A>
+constexpr int findFixedArt(const FixedArt (&arts)[A], std::string_view name) {
+    for (size_t i = 0; i < A; i++)
+        if (arts[i].name == name)
+            return static_cast<int>(i);
+    return -1;
+}
+
+template <size_t A, size_t S>
+constexpr bool fixedArtsExist(const FixedArt (&arts)[A], const FixedScene (&scenes)[S]) {
+    for (const FixedScene &s : scenes)
+        if (findFixedArt(arts, s.art) < 0)
+            return false;
+    return true;
+}
+
+// Condições e efeitos compilam, com no máximo 64 marcadores na história, e só as primeiras
+// MAX_CONDITIONAL_CHOICES escolhas de cada cena têm condição
+template <size_t S, size_t C>
+constexpr bool fixedChoiceCodeIsValid(const FixedScene (&)[S], const FixedChoice (&choices)[C]) {
+    DecisionSymbols symbols;
+    int index = 0;
+    for (size_t c = 0; c < C; c++) {
+        index = c > 0 && choices[c].sceneId == choices[c - 1].sceneId ? index + 1 : 0;
+        if (!choices[c].condition.empty()) {
+            if (index >= MAX_CONDITIONAL_CHOICES || !DecisionCompiler::compileCondition(choices[c].condition, symbols).ok())
+                return false;
+        }
+        if (!choices[c].effect.empty() && !DecisionCompiler::compileEffect(choices[c].effect, symbols).ok())
+            return false;
+    }
+    return true;
+}
+
+/*
+FixedPackedArts
+Função: As artes de uma tabela FixedArt como ficam no pool: comprimidas por ArtCodec quando isso as deixa menores (a mesma regra do StoryCompiler), ou como estão.
+Cada arte é comprimida em uma avaliação constexpr própria (FIXED_PACKED_ART), porque o compilador limita o número de operações de cada uma; montar o conjunto só copia bytes.
+*/
+template <size_t A, size_t Bytes>
+struct FixedPackedArts {
+    std::array<char, Bytes> bytes{};
+    std::array<size_t, A> start{};
+    std::array<size_t, A> size{};
+    std::array<bool, A> packed{};
+
+    constexpr std::string_view get(size_t i) const { return std::string_view(bytes.data() + start[i], size[i]); }
+};
+
+// Uma arte como vai para o pool; comprimida ela só é usada se ficar menor, então cabe em N bytes
+template <size_t N>
+struct FixedPackedArt {
+    std::array<char, N> bytes{};
+    size_t size = 0;
+    bool packed = false;
+};
+
+template <size_t N>
+constexpr FixedPackedArt<N> packFixedArt(std::string_view text) {
+    FixedPackedArt<N> art{};
+    if (text.size() <= ArtCodec::MAX_DECODED) {
+        std::string packed = ArtCodec::compress(text);
+        art.packed = packed.size() < text.size();
+        for (size_t i = 0; art.packed && i < packed.size(); i++)
+            art.bytes[art.size++] = packed[i];
+    }
+    for (size_t i = 0; !art.packed && i < text.size(); i++)
+        art.bytes[art.size++] = text[i];
+    return art;
+}
+
+template <const auto &Arts, size_t I>
+inline constexpr auto FIXED_PACKED_ART = packFixedArt<Arts[I].text.size()>(Arts[I].text);
+
+template <const auto &Arts, size_t... I>
+constexpr auto packFixedArts(std::index_sequence<I...>) {
+    FixedPackedArts<sizeof...(I), (FIXED_PACKED_ART<Arts, I>.size + ... + 0)> arts{};
+    size_t used = 0;
+    auto add = [&](size_t i, const auto &art) {
+        arts.start[i] = used;
+        arts.size[i] = art.size;
+        arts.packed[i] = art.packed;
+        for (size_t k = 0; k < art.size; k++)
+            arts.bytes[used++] = art.bytes[k];
+    };
+    (add(I, FIXED_PACKED_ART<Arts, I>), ...);
+    return arts;
+}
+
+// Artes da tabela "Arts" como ficam no pool; use em uma variável constexpr e passe a fixedStoryPoolSize e compileFixedStory
+template <const auto &Arts>
+constexpr auto packFixedArts() {
+    return packFixedArts<Arts>(std::make_index_sequence<std::size(Arts)>());
+}
+
+/*
+FixedStoryTexts
+Função: Textos e programas na ordem em que o StoryCompiler os grava no pool: arte (como em FixedPackedArts) e narrativa de cada cena, seguidas de texto, condição e efeitos de cada escolha dela. Os programas são compilados aqui, com os marcadores numerados nessa mesma ordem; condições e efeitos ausentes ficam marcados e não entram no pool.
+*/
+template <size_t N, size_t CodeBytes>
+struct FixedStoryTexts {
+    std::array<std::string_view, N> text{};
+    std::array<int, N> codeStart{};  // -1 para textos
+    std::array<int, N> codeSize{};
+    std::array<bool, N> present{};
+    std::array<char, CodeBytes> code{};
+
+    constexpr std::string_view get(size_t i) const {
+        return codeStart[i] >= 0 ? std::string_view(code.data() + codeStart[i], codeSize[i]) : text[i];
+    }
+};
+
+template <size_t A, size_t B, size_t S, size_t C>
+constexpr FixedStoryTexts<2 * S + 3 * C, 2 * C * DECISION_MAX_CODE> fixedStoryTexts(const FixedArt (&arts)[A], const FixedPackedArts<A, B> &packedArts,
+                                                                                    const FixedScene (&scenes)[S], const FixedChoice (&choices)[C]) {
+    FixedStoryTexts<2 * S + 3 * C, 2 * C * DECISION_MAX_CODE> texts{};
+    DecisionSymbols symbols;
+    size_t n = 0, c = 0;
+    int codeUsed = 0;
+    auto addText = [&](std::string_view text) {
+        texts.text[n] = text;
+        texts.codeStart[n] = -1;
+        texts.present[n++] = true;
+    };
+    auto addCode = [&](const DecisionCode &code, bool present) {
+        texts.codeStart[n] = codeUsed;
+        texts.codeSize[n] = present ? code.size : 0;
+        texts.present[n++] = present;
+        for (int i = 0; present && i < code.size; i++)
+            texts.code[codeUsed++] = static_cast<char>(code.bytes[i]);
+    };
+    for (const FixedScene &s : scenes) {
+        int art = findFixedArt(arts, s.art);
+        addText(art >= 0 ? packedArts.get(art) : std::string_view());
+        addText(s.narrative);
+        for (; c < C && choices[c].sceneId == s.id; c++) {
+            addText(choices[c].text);
+            bool hasCondition = !choices[c].condition.empty();
+            addCode(hasCondition ? DecisionCompiler::compileCondition(choices[c].condition, symbols) : DecisionCode(), hasCondition);
+            bool hasEffect = !choices[c].effect.empty();
+            addCode(hasEffect ? DecisionCompiler::compileEffect(choices[c].effect, symbols) : DecisionCode(), hasEffect);
+        }
+    }
+    return texts;
+}
+
+// Tamanho do pool de textos, com cada texto ou programa distinto gravado uma única vez
+template <size_t A, size_t B, size_t S, size_t C>
+constexpr size_t fixedStoryPoolSize(const FixedArt (&arts)[A], const FixedPackedArts<A, B> &packedArts, const FixedScene (&scenes)[S],
+                                    const FixedChoice (&choices)[C]) {
+    auto texts = fixedStoryTexts(arts, packedArts, scenes, choices);
+    size_t size = 0;
+    for (size_t i = 0; i < texts.text.size(); i++) {
+        if (!texts.present[i])
+            continue;
+        bool repeated = false;
+        for (size_t j = 0; j < i && !repeated; j++)
+            repeated = texts.present[j] && texts.get(j) == texts.get(i);
+        if (!repeated)
+            size += texts.get(i).size();
+    }
+    return size;
+}
+
+/*
+FixedStoryImage
+Função: Imagem binária da história (cabeçalho, tabelas e pool) em um único objeto constante, no formato descrito em jogo_historia.cpp. Todos os campos têm 32 bits, então não há preenchimento entre as seções e o objeto pode ser passado diretamente a StoryGraph::attach.
+*/
+template <size_t Slots, size_t Choices, size_t Pool>
+struct FixedStoryImage {
+    StoryFileHeader header;
+    StorySceneRecord scenes[Slots];
+    StoryChoiceRecord choices[Choices];
+    char pool[Pool];
+
+    const void *data() const { return this; }
+    size_t size() const { return header.stringPoolOffset + header.stringPoolSize; }
+};
+
+// Monta a imagem durante a compilação; "Pool" vem de fixedStoryPoolSize com as mesmas tabelas e artes comprimidas
+template <size_t Pool, size_t A, size_t B, size_t S, size_t C>
+constexpr FixedStoryImage<S + 1, C, Pool> compileFixedStory(const FixedArt (&arts)[A], const FixedPackedArts<A, B> &packedArts,
+                                                            const FixedScene (&scenes)[S], const FixedChoice (&choices)[C]) {
+    FixedStoryImage<S + 1, C, Pool> image{};
+    auto texts = fixedStoryTexts(arts, packedArts, scenes, choices);
+    std::array<uint32_t, 2 * S + 3 * C> offsets{};
+    uint32_t poolSize = 0;
+    for (size_t i = 0; i < texts.text.size(); i++) {
+        if (!texts.present[i]) {
+            offsets[i] = DECISION_NO_CODE;
+            continue;
+        }
+        size_t first = i;
+        for (size_t j = 0; j < i && first == i; j++)
+            if (texts.present[j] && texts.get(j) == texts.get(i))
+                first = j;
+        if (first < i) {
+            offsets[i] = offsets[first];
+            continue;
+        }
+        offsets[i] = poolSize;
+        for (char ch : texts.get(i))
+            image.pool[poolSize++] = ch;
+    }
+
+    size_t n = 0, c = 0;
+    for (const FixedScene &s : scenes) {
+        StorySceneRecord &r = image.scenes[s.id];
+        int art = findFixedArt(arts, s.art);
+        r.flags = SCENE_EXISTS | (s.ending ? SCENE_ENDING : 0) | (art >= 0 && packedArts.packed[art] ? SCENE_ART_PACKED : 0);
+        r.artOffset = offsets[n];
+        r.artLength = static_cast<uint32_t>(texts.get(n++).size());
+        r.narrativeOffset = offsets[n];
+        r.narrativeLength = static_cast<uint32_t>(texts.get(n++).size());
+        r.firstChoice = static_cast<uint32_t>(c);
+        for (; c < C && choices[c].sceneId == s.id; c++) {
+            image.choices[c] = {offsets[n], static_cast<uint32_t>(texts.get(n).size()), choices[c].targetSceneId,
+                                offsets[n + 1], offsets[n + 2]};
+            if (!choices[c].condition.empty())
+                r.flags |= SCENE_CONDITIONAL;
+            n += 3;
+        }
+        r.choiceCount = static_cast<uint32_t>(c - r.firstChoice);
+    }
+
+    StoryFileHeader &h = image.header;
+    for (int i = 0; i < 4; i++)
+        h.magic[i] = STORY_MAGIC[i];
+    h.version = STORY_VERSION;
+    h.startSceneId = 1;
+    h.sceneSlots = S + 1;
+    h.choiceCount = C;
+    h.stringPoolSize = poolSize;
+    h.scenesOffset = sizeof(StoryFileHeader);
+    h.choicesOffset = h.scenesOffset + (S + 1) * sizeof(StorySceneRecord);
+    h.stringPoolOffset = h.choicesOffset + C * sizeof(StoryChoiceRecord);
+
+    // contentHash: os mesmos bytes que StoryHash::ofImage percorre na memória, campo a campo
+    StoryHash hash;
+    for (int i = 0; i < 4; i++)
+        hash.add(static_cast<uint8_t>(h.magic[i]));
+    for (uint32_t word : {h.version, static_cast<uint32_t>(h.startSceneId), h.sceneSlots, h.choiceCount, h.stringPoolSize,
+                          h.scenesOffset, h.choicesOffset, h.stringPoolOffset, 0u})
+        hash.addWord(word);
+    for (const StorySceneRecord &r : image.scenes)
+        for (uint32_t word : {r.flags, r.artOffset, r.artLength, r.narrativeOffset, r.narrativeLength, r.firstChoice, r.choiceCount})
+            hash.addWord(word);
+    for (const StoryChoiceRecord &c : image.choices)
+        for (uint32_t word : {c.textOffset, c.textLength, static_cast<uint32_t>(c.targetSceneId), c.conditionOffset, c.effectOffset})
+            hash.addWord(word);
+    for (uint32_t i = 0; i < poolSize; i++)
+        hash.add(static_cast<uint8_t>(image.pool[i]));
+    h.contentHash = hash.value;
+    return image;
+}
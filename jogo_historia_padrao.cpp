@@ -0,0 +1,332 @@
+#pragma once
+#include "jogo_historia_fixa.cpp"
+
+/*
+História padrão
+Função: A aventura que acompanha o jogo, definida em tabelas constexpr (ver jogo_historia_fixa.cpp). O compilador confere as tabelas, comprime as artes e gera a imagem binária HISTORIA_PADRAO, usada pelo Game sem montar nada em tempo de execução; o historia.txt tem o mesmo conteúdo no formato de texto.
+As cenas 10 e 11 (o labirinto e o demônio) foram inseridas depois na história e já usaram os ids 35 e 36.
+*/
+
+// ASCII arts do jogo
+constexpr FixedArt ARTES_PADRAO[] = {
+    {"montanhas", R"(
+         /\          /\          /\
+        /  \   /\   /  \   /\   /  \
+       /    \ /  \ /    \ /  \ /    \
+      /      \    /      \    /      \
+     /        \  /        \  /        \
+    /  /\      \/          \/      /\   \
+   /  /  \      |   ~~~~   |      /  \   \
+  /__/____\     |  ~~~~~~  |     /____\___\
+                \~~~~~~~~~~/ 
+                 \~~~~~~~~/ 
+                  \~~~~~~/ 
+                   \~~~~/ 
+                    \~~/ 
+                     \/ 
+
+            )"},
+    {"castelo", R"(
+                                    |>>>                              
+                                  |                                 
+                    |>>>      _  _|_  _         |>>>                
+                    |        |;| |;| |;|        |                   
+                _  _|_  _    \\.    .  /    _  _|_  _               
+               |;|_|;|_|;|    \\:. ,  /    |;|_|;|_|;|              
+               \\..      /    ||;   . |    \\.    .  /              
+                \\.  ,  /     ||:  .  |     \\:  .  /               
+                 ||:   |_   _ ||_ . _ | _   _||:   |                
+                 ||:  .|||_|;|_|;|_|;|_|;|_|;||:.  |                
+                 ||:   ||.    .     .      . ||:  .|                
+                 ||: . || .     . .   .  ,   ||:   |       \,/      
+                 ||:   ||:  ,  _______   .   ||: , |            /`\ 
+                 ||:   || .   /+++++++\    . ||:   |                
+                 ||:   ||.    |+++++++| .    ||: . |                
+              __ ||: . ||: ,  |+++++++|.  . _||_   |                
+     ____--`~    '--~~__|.    |+++++__|----~    ~`---,              
+-~--~                   ~---__|,--~'                  ~~----_____-~'
+            )"},
+    {"endgame", R"(
+ <>=======() 
+(/\___   /|\\          ()==========<>_
+      \_/ | \\        //|\   ______/ \)
+        \_|  \\      // | \_/
+          \|\/|\_   //  /\/
+           (oo)\ \_//  /
+          //_/\_\/ /  |
+         @@/  |=\  \  |
+              \_=\_ \ |
+                \==\ \|\_ snd
+             __(\===\(  )\
+            (((~) __(_/   |
+                 (((~) \  /
+                 ______/ /
+                 '------'
+            )"},
+    {"gameover", R"(
+            ⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀                                    .""--..__
+                     _                     []       ``-.._
+                  .'` `'.                  ||__           `-._
+                 /    ,-.\                 ||_ ```---..__     `-.
+                /    /:::\\               /|//}          ``--._  `.
+                |    |:::||              |////}                `-. \
+                |    |:::||             //'///                    `.\
+                |    |:::||            //  ||'                      `|
+        jgs     /    |:::|/        _,-//\  ||
+        hh     /`    |:::|`-,__,-'`  |/  \ ||
+             /`  |   |'' ||           \   |||
+           /`    \   |   ||            |  /||
+         |`       |  |   |)            \ | ||
+        |          \ |   /      ,.__    \| ||
+        /           `         /`    `\   | ||
+       |                     /        \  / ||
+       |                     |        | /  ||
+       /         /           |        `(   ||
+      /          .           /          )  ||
+     |            \          |     ________||
+    /             |          /     `-------.|
+   |\            /          |              ||
+   \/`-._       |           /              ||
+    //   `.    /`           |              ||
+   //`.    `. |             \              ||
+  ///\ `-._  )/             |              ||
+ //// )   .(/               |              ||
+ ||||   ,'` )               /              //
+ ||||  /                    /             || 
+ `\\` /`                    |             // 
+     |`                     \            ||  
+    /                        |           //  
+  /`                          \         //   
+/`                            |        ||    
+`-.___,-.      .-.        ___,'        (/    
+         `---'`   `'----'`
+
+            )"},
+    {"mago_ataque", R"(
+                    '             .           .
+    o       '   o  .     '   . O
+'   .   ' .   _____  '    .      .
+    .     .   .mMMMMMMMm.  '  o  '   .
+'   .     .MMXXXXXXXXXMM.    .   ' 
+.       . /XX77:::::::77XX\ .   .   .
+    o  .  ;X7:::''''''':::7X;   .  '
+'    . |::'.:'        '::| .   .  .
+    .   ;:.:.            :;. o   .
+'     . \'.:            /.    '   .
+    .     `.':.        .'.  '    .
+    '   . '  .`-._____.-'   .  . '  .
+    ' o   '  .   O   .   '  o    '
+    . ' .  ' . '  ' O   . '  '   '
+    . .   '    '  .  '   . '  '
+        . .'..' . ' ' . . '.  . '
+        `.':.'        ':'.'.'
+        `\\_  |     _//'
+            \(  |\    )/
+            //\ |_\  /\\
+            (/ /\(" )/\ \)
+            \/\ (  ) /\/
+                |(  )|
+                | \( \
+                |  )  \
+                |      \
+                |       \
+                |        `.__,
+                \_________.-'Ojo/gnv
+            )"},
+    {"dragao", R"(
+       ^    ^
+               / \  //\
+ |\___/|      /   \//  .\
+ /O  O  \__  /    //  | \ \
+/     /  \/_/    //   |  \  \
+@___@'    \/_   //    |   \   \ 
+   |       \/_ //     |    \    \ 
+   |        \///      |     \     \ 
+  _|_ /   )  //       |      \     _\
+ '/,_ _ _/  ( ; -.    |    _ _\.-~        .-~~~^-.
+ ,-{        _      `-.|.-~-.           .~         `.
+  '/\      /                 ~-. _ .-~      .-~^-.  \
+     `.   {            }                   /      \  \
+   .----~-.\        \-'                 .~         \  `. \^-.
+  ///.----..>    c   \             _ -~             `.  ^-`   ^-_
+    ///-._ _ _ _ _ _ _}^ - - - - ~                     ~--,   .-~
+                                                          /.-'
+⠀⠀
+            )"},
+    {"bruxa", R"(
+                    Ash nazg durbatulûk
+                    agh burzum-ishi
+(       "     )   krimpatul
+( _  *           Gûlburz agh dûmûrz
+    * (     /      \    ___
+        "     "        _/ /
+        (   *  )    ___/   |
+        )   "     _ o)'-./__
+        *  _ )    (_, . $$$
+        (  )   __ __ 7_ $$$$
+        ( :  { _)  '---  $\
+    ______'___//__\   ____, \
+    )           ( \_/ _____\_
+    .'             \   \------''.
+    |='           '=|  |         )
+    |               |  |  .    _/
+    \    (. ) ,   /  /__I_____\
+snd  '._/_)_(\__.'   (__,(__,_]
+    @---()_.'---@
+            )"},
+    {"ogro", R"(
+            __,='`````'=/__
+            '//  (o) \(o) \ `'         _,-,
+            //|     ,_)   (`\      ,-'`_,-\
+        ,-~~~\  `'==='  /-,      \==```` \__
+        /        `----'     `\     \       \/
+    ,-`                  ,   \  ,.-\       \
+    /      ,               \,-`\`_,-`\_,..--'\
+    ,`    ,/,              ,>,   )     \--`````\
+    (      `\`---'`  `-,-'`_,<   \      \_,.--'`
+    `.      `--. _,-'`_,-`  |    \
+    [`-.___   <`_,-'`------(    /
+    (`` _,-\   \ --`````````|--`
+        >-`_,-`\,-` ,          |
+    <`_,'     ,  /\          /
+    `  \/\,-/ `/  \/`\_/V\_/
+        (  ._. )    ( .__. )
+        |      |    |      |
+        \,---_|    |_---./
+        ooOO(_)    (_)OOoo
+            )"},
+    {"mago", R"(
+              _,._      
+  .||,       /_ _\\     
+ \.`',/      |'L'| |    
+ = ,. =      | -,| L    
+ / || \    ,-'\"/,'`.   
+   ||     ,'   `,,. `.  
+   ,|____,' , ,;' \| |  
+  (3|\    _/|/'   _| |  
+   ||/,-''  | >-'' _,\\ 
+   ||'      ==\ ,-'  ,' 
+   ||       |  V \ ,|   
+   ||       |    |` |   
+   ||       |    |   \  
+   ||       |    \    \ 
+   ||       |     |    \
+   ||       |      \_,-'
+   ||       |___,,--")_\
+   ||         |_|   ccc/
+   ||        ccc/       
+   ||                hjm
+            )"},
+    {"cavaleiro", R"(
+    / \
+    | |
+    |.|
+    |.|
+    |:|      __
+ ,_|:|_,   /  )
+   (Oo    / _I_
+    +\ \  || __|
+       \ \||___|
+         \ /.:.\-\
+           |.:. /-----\
+           |___|::oOo::|
+          /   |:<_T_>:|
+         |_____\ ::: /
+         | |  \ \:/
+         | |   | |
+         \ /   | \___
+         / |   \_____\
+            )"},
+    {"intro", R"(
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;;;;;;;;;;;;;;;;-' ___      '-;;;;;;;;;;;;;;;;
+;;;;;;;;;;;;-'    `'-.`'-.      '-;;;;;;;;;;;;
+;;;;;;;;;;'           )   `\       ';;;;;;;;;;
+;;;;;;;;'            /      \   ^V^  ';;;;;;;;
+;;;;;;;           __/________\__       ;;;;;;;
+;;;;;;  ^V^      '--/}}}}}}"}}--'       ;;;;;;
+;;;;;              {{{{{{  aa\__         ;;;;;
+;;;;;              }}}}} ,___ __}        ;;;;;
+;;;;;             {{{{{\  \_//           ;;;;;
+;;;;;              }}}}//'--u            ;;;;;
+;;;;;        _     .--'`U\               ;;;;;
+;;;;;   ::::| \   (   _,\\\              ;;;;;
+;;;;;;  ::::|  |===\  \\=\))=======D    ;;;;;;
+;;;;;;; ::::|_/     `> \\              ;;;;;;;
+;;;;;;;;.           /__//            .;;;;;;;;
+;;;;;;;;;;.         Y\_\\_         .;;;;;;;;;;
+;;;;;;;;;;;;-._                _.-;;;;;;;;;;;;
+;;;;;;;jgs;;;;;;-.          .-;;;;;;;;;;;;;;;;
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;; 
+            )"},
+    {"demo", R"(
+                     ,-.
+       ___,---.__          /'|`\          __,---,___
+    ,-'    \`    `-.____,-'  |  `-.____,-'    //    `-.
+  ,'        |           ~'\     /`~           |        `.
+ /      ___//              `. ,'          ,  , \___      \
+|    ,-'   `-.__   _         |        ,    __,-'   `-.    |
+|   /          /\_  `   .    |    ,      _/\          \   |
+\  |           \ \`-.___ \   |   / ___,-'/ /           |  /
+ \  \           | `._   `\\  |  //'   _,' |           /  /
+  `-.\         /'  _ `---'' , . ``---' _  `\         /,-'
+     ``       /     \    ,='/ \`=.    /     \       ''
+             |__   /|\_,--.,-.--,--._/|\   __|
+             /  `./  \\`\ |  |  | /,//' \,'  \
+eViL        /   /     ||--+--|--+-/-|     \   \
+           |   |     /'\_\_\ | /_/_/`\     |   |
+            \   \__, \_     `~'     _/ .__/   /
+             `-._,-'   `-._______,-'   `-._,-'
+            )"},
+    {"template", R"(
+            )"},
+};
+
+// Cenas em ordem de id
+constexpr FixedScene CENAS_PADRAO[] = {
+    {1, "intro", "Em um reino muito distante chamado Exandria uma bruxa muito má estava selada em uma rocha e após 100 anos o selo enfraqueceu e ela se libertou...Após se libertar, a Bruxa voou em direção ao reino de Exandria que era comandado pelos descendentes daqueles que a selaram, chegando lá ela percebeu que estava ocorrendo um festival, onde os Reis e rainhas de todos os reinos se reuniam para celebrar a paz entre eles, aproveitando essa oportunidade a bruxa esperou o momento em que o rei e rainha do reino anfitrião apareceriam para declarar inicio ao festival e os matou na frente de todos, declarando guerra ao todos os reinos e avisando para se preparem que voltaria para destruir todos os reinos um a um e saiu. A filha do rei e rainha que foram mortos pela Bruxa, a princesa Fiona, presenciou todo o assassinato e a declaração de guerra e se enfureceu...Você foi convocado para fazer parte do exercito que deseja derrotar a bruxa, você aceita o desafio? < S | N >"},
+    {2, "cavaleiro", "Escolha sua classe:."},
+    {3, "ogro", "Cap I Parte - I: A floresta \n Ao entrar no exército você foi ao castelo da princesa fiona onde todos foram convocados para receber as primeiras instruções...Chegando no castelo, você estranhou, pois só tinha você, um (mago ou cavaleiro, a classe que restou) e um aldeão, e se questionou se estava no lugar certo, e logo em seguida a princesa foi até vocês e se pronunciou: \n-Olá bravos guerreiros, sinto dizer que só restou a nós, tínhamos um exército com mais de 10 mil homens mas todos foram mortos pela Bruxa na primeira tentativa de invasão, mas convoquei vocês aqui porque a morte desses homens não foi em vão, eles nos deixaram um pedaço de pergaminho com um mapa até a Bruxa e todos os possíveis perigos que nós iremos enfrentar.\nE logo o aldeão pergunta:\n -Nós? Você irá conosco? E seremos so nós?\n E a princesa responde:\n -Sim! Não perderei a oportunidade de vingar meus pais, além disso, durante toda minha vida fui treinada por uma feiticeira que aconselhava minha família, então poderei lutar ao lado de vocês.\nE respondendo a sua segunda pergunta, Sim! Seremos só nós, e será o suficiente para acabar com a Bruxa agora que temos esse pergaminho.-\nApós a pequena reunião e sanadas as dúvidas entre o grupo, o mesmo se dirige para floresta em busca do covil da bruxa e é surpreendido por um grupo de ogros atacando aldeões.\n[Missão 01] Derrote os ogros antes que eles matem os aldeões, PREPARE-SE PARA O COMBATE!"},
+    {4, "bruxa", "Cap II: A bruxa \n Após a batalha no labirinto, vocês andam por muitas horas em busca do covil, seguindo o mapa que vocês possuem, o cheiro de pântano começa a crescer, a umidade se tora desconfortável, uma névoa vem crescendo ha dias, de repente vocês saem do labirinto e se deparam com uma criatura na entrada de um covil, aparentemente realizando algum tipo de ritual, o que deseja fazer:"},
+    {5, "dragao", "Cap III: A segunda forma \n Vocês lutaram bravamente e derrotaram a bruxa, mas as coisas não são tão fáceis quanto parece, quando olham para o corpo dela desfalecido no chão, percebem que a sua pele começa a mudar, olhos amarelando, dentes afiados e a seu tamanho aumentando, de repente, um dragão aparece.\n[Missão 02: Derrote o dragão]"},
+    {6, "mago_ataque", "Percebendo que a luta com o dragão estava bastante perigosa a princesa desperta um poder ancestral e canaliza toda a energia para destruir o dragão, salvando todos do grupo. O dragão se debate, gorgoleja e finalmente é derrotado.."},
+    {7, "castelo", "Parabéns, com a derrota do dragão o reino provou uma paz por alguns anos ! "},
+    {8, "endgame", "Porém tudo que é bom dura pouco, boatos surgem e parece que a bruxa deixou ovos de dragão escondidos na floresta, que eclodiram com o passar dos anos e agora relatos de diversos dragões atacando outros reinos tem se tornado frequentes, talvez ainda precisaremos da sua ajuda aventureiro.\n <<FIM>>", true},
+    {9, "gameover", "Você morreu. Deseja tentar de novo?", true},
+    {10, "demo", "Vocês vencem os ogros após muito sacrifício, porém na busca pela bruxa vocês chegam ao labirinto e devem encontrar a entrada do covil, mas agora estão parados em uma bifurcação com 03 salas que não estavam registrados no mapa, qual deseja entrar?"},
+    {11, "demo", "Um demônio foi conjurado pegando vocês de surpresa, não há como vencer !"},
+};
+
+// Escolhas de cada cena: {cena, descrição, cena alvo, condição, efeitos} (a aventura padrão não usa condições nem efeitos;
+// ver historia_decisoes.txt)
+constexpr FixedChoice ESCOLHAS_PADRAO[] = {
+    {1, "Sim, aceito a missão de matar a bruxa!", 2},
+    {1, "Não, vai procurar o que fazer..", 9},
+    {2, "Cavaleiro", 3},
+    {2, "Mago", 3},
+    {3, "Iniciar o combate", 10},
+    {4, "Aproximar-se sorrateiramente", 5},
+    {4, "Atacar com tudo", 9},
+    {5, "Iniciar o combate", 6},
+    {6, "Iniciar o combate:", 7},
+    {7, "Pressione para continuar", 8},
+    {8, "Voltar ao início", 1},
+    {9, "Sim", 1},
+    {9, "Não", 2},
+    {10, "Sala Clara", 11},
+    {10, "Sala meio iluminada", 4},
+    {10, "Sala Escura", 4},
+    {11, "Enfrentar assim mesmo", 9},
+    {11, "Fugir imediatamente", 4},
+};
+
+static_assert(fixedSceneIdsAreDense(CENAS_PADRAO), "as cenas precisam ter ids 1, 2, 3... na ordem da tabela");
+static_assert(fixedChoicesAreGrouped(CENAS_PADRAO, ESCOLHAS_PADRAO), "escolha de uma cena inexistente ou fora da ordem das cenas");
+static_assert(fixedChoiceTargetsExist(CENAS_PADRAO, ESCOLHAS_PADRAO), "escolha aponta para uma cena inexistente");
+static_assert(fixedArtsExist(ARTES_PADRAO, CENAS_PADRAO), "cena usa uma arte inexistente");
+static_assert(fixedChoiceCodeIsValid(CENAS_PADRAO, ESCOLHAS_PADRAO), "condição ou efeito de escolha inválido");
+
+inline constexpr auto ARTES_PADRAO_COMPRIMIDAS = packFixedArts<ARTES_PADRAO>();
+inline constexpr auto HISTORIA_PADRAO = compileFixedStory<fixedStoryPoolSize(ARTES_PADRAO, ARTES_PADRAO_COMPRIMIDAS, CENAS_PADRAO, ESCOLHAS_PADRAO)>(
+    ARTES_PADRAO, ARTES_PADRAO_COMPRIMIDAS, CENAS_PADRAO, ESCOLHAS_PADRAO);
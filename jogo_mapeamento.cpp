@@ -0,0 +1,109 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+MappedFile
+Função: Mapeia um arquivo inteiro em memória somente para leitura (CreateFileMapping no Windows, mmap nos demais sistemas). O conteúdo é carregado pelo sistema operacional sob demanda, página a página, e processos que mapeiam o mesmo arquivo compartilham as mesmas páginas físicas.
+*/
+class MappedFile {
+    public:
+        MappedFile() {}
+        ~MappedFile() { close(); }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        // Abre e mapeia o arquivo; retorna false se ele não existir, estiver vazio ou não puder ser mapeado
+        bool open(const std::string &path) {
+            close();
+#ifdef _WIN32
+            file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                return false;
+            LARGE_INTEGER tamanho;
+            if (!GetFileSizeEx(file, &tamanho) || tamanho.QuadPart == 0) {
+                close();
+                return false;
+            }
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping == nullptr) {
+                close();
+                return false;
+            }
+            bytes = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            if (bytes == nullptr) {
+                close();
+                return false;
+            }
+            length = static_cast<size_t>(tamanho.QuadPart);
+#else
+            fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                return false;
+            struct stat info;
+            if (fstat(fd, &info) != 0 || info.st_size == 0) {
+                close();
+                return false;
+            }
+            void *endereco = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            if (endereco == MAP_FAILED) {
+                close();
+                return false;
+            }
+            bytes = static_cast<const char *>(endereco);
+            length = static_cast<size_t>(info.st_size);
+#endif
+            return true;
+        }
+
+        void close() {
+#ifdef _WIN32
+            if (bytes != nullptr)
+                UnmapViewOfFile(bytes);
+            if (mapping != nullptr)
+                CloseHandle(mapping);
+            if (file != INVALID_HANDLE_VALUE)
+                CloseHandle(file);
+            mapping = nullptr;
+            file = INVALID_HANDLE_VALUE;
+#else
+            if (bytes != nullptr)
+                munmap(const_cast<char *>(bytes), length);
+            if (fd >= 0)
+                ::close(fd);
+            fd = -1;
+#endif
+            bytes = nullptr;
+            length = 0;
+        }
+
+        bool isOpen() const { return bytes != nullptr; }
+        const char *data() const { return bytes; }
+        size_t size() const { return length; }
+
+    private:
+        const char *bytes = nullptr;
+        size_t length = 0;
+#ifdef _WIN32
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#else
+        int fd = -1;
+#endif
+};
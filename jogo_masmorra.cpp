@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include "jogo_dados.cpp"
+
+/*
+Sala
+Função: Conteúdo de uma sala da masmorra, gerado por Masmorra::sala. Os valores seguem os dados que o jogo_encontros rolava ao entrar: "entrada" é o d4 do caminho até a sala, "acontecimento" o d6 do que há dentro dela.
+*/
+struct Sala {
+    uint32_t profundidade = 0;    // Salas atravessadas desde a entrada da masmorra
+    uint64_t indice = 0;          // Posição entre as salas da mesma profundidade
+    unsigned modificador = 0;     // Bônus dos eventos: 0 (sala clara), 1 (meio iluminada) ou 3 (escura)
+    int entrada = 1;              // 1 sem problemas, 2 armadilha, 3 tranquila, 4 gases enfraquecedores
+    int danoArmadilha = 0;        // d10, com entrada 2
+    int enfraquecimento = 0;      // d8, com entrada 4
+    int acontecimento = 6;        // 1 a 4 algo para examinar, 5 ogros, 6 vazia
+    int ogros = 0;                // d4, com acontecimento 5
+    bool passagemSecreta = false; // d100 > 95: quem errar a porta aqui acha a sala secreta em vez do abismo
+};
+
+/*
+Masmorra
+Função: Masmorra procedural em que cada sala é derivada só da semente e da sua coordenada (profundidade, indice), com um gerador próprio semeado por um hash dos três valores. Nenhuma sala é guardada: elas são geradas na hora, ao entrar, e saem iguais em qualquer reprodução com a mesma semente, então a masmorra pode ter milhões de salas sem ocupar memória. Quem explora só guarda a coordenada da sala atual.
+As salas formam uma árvore de três portas: a porta p (1 a 3) da sala (d, i) leva à sala (d + 1, 3i + p - 1), cuja iluminação é a da porta (clara, meio iluminada ou escura). Depois de 40 salas de profundidade o índice dá a volta nos 64 bits, o que só repete conteúdos, sem quebrar o determinismo.
+*/
+class Masmorra {
+    public:
+        static constexpr unsigned PORTAS = 3;
+
+        explicit Masmorra(uint64_t semente = 0) : semente(semente) {}
+
+        uint64_t getSemente() const { return semente; }
+
+        // Sala na coordenada (profundidade, indice); a sala (0, 0) é a entrada
+        Sala sala(uint32_t profundidade, uint64_t indice) const {
+            static const unsigned MODIFICADORES[PORTAS] = {0, 1, 3};
+            Dados dados(hash(profundidade, indice));
+            Sala s;
+            s.profundidade = profundidade;
+            s.indice = indice;
+            s.modificador = profundidade == 0 ? 0 : MODIFICADORES[indice % PORTAS];
+            s.entrada = dados.rolar(d4);
+            s.danoArmadilha = dados.rolar(d10);
+            s.enfraquecimento = dados.rolar(d8);
+            s.acontecimento = dados.rolar(d6);
+            s.ogros = dados.rolar(d4);
+            s.passagemSecreta = dados.rolar(d100) > 95;
+            if (s.entrada != 2)
+                s.danoArmadilha = 0;
+            if (s.entrada != 4)
+                s.enfraquecimento = 0;
+            if (s.acontecimento != 5)
+                s.ogros = 0;
+            return s;
+        }
+
+        // Sala do outro lado da porta "porta" (1 a PORTAS) de "atual"
+        Sala vizinha(const Sala &atual, unsigned porta) const {
+            return sala(atual.profundidade + 1, atual.indice * PORTAS + (porta - 1));
+        }
+
+    private:
+        // Mistura (semente, profundidade, indice) em uma semente independente por sala
+        uint64_t hash(uint32_t profundidade, uint64_t indice) const {
+            uint64_t h = semente ^ (static_cast<uint64_t>(profundidade) * 0xD6E8FEB86659FD93ull);
+            h = (h ^ (h >> 32)) * 0xD6E8FEB86659FD93ull;
+            h ^= indice * Dados::GAMMA;
+            h = (h ^ (h >> 32)) * 0xD6E8FEB86659FD93ull;
+            return h ^ (h >> 32);
+        }
+
+        uint64_t semente;
+};
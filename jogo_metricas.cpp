@@ -0,0 +1,218 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+// Contadores globais (somados entre as threads)
+enum class Counter : uint32_t {
+    Sessions,        // Partidas iniciadas (Game::play)
+    SceneDisplays,   // Chamadas de Scene::display
+    Choices,         // Escolhas aplicadas
+    InvalidChoices,  // Escolhas recusadas (número fora das opções visíveis)
+    EventGood,       // Evento_Randomico: evento_bom
+    EventNeutral,    // Evento_Randomico: evento_neutro
+    EventBad,        // Evento_Randomico: evento_ruim
+    EventDeclined,   // Evento_Randomico: jogador não quis explorar ("n")
+    EventBadAnswer,  // Evento_Randomico: resposta que não é "s" nem "n"
+    Count
+};
+constexpr const char *COUNTER_NAMES[] = {"sessions", "scene_displays", "choices", "invalid_choices", "event_good",
+    "event_neutral", "event_bad", "event_declined", "event_bad_answer"};
+static_assert(std::size(COUNTER_NAMES) == static_cast<size_t>(Counter::Count), "um nome por contador");
+
+// Histogramas de durações em nanossegundos
+enum class Histogram : uint32_t {
+    ChoiceLatency, // Do pedido da escolha até a resposta do jogador
+    Count
+};
+constexpr const char *HISTOGRAM_NAMES[] = {"choice_latency_ns"};
+static_assert(std::size(HISTOGRAM_NAMES) == static_cast<size_t>(Histogram::Count), "um nome por histograma");
+
+constexpr uint32_t METRIC_SCENES = 256;     // Cenas com contagem própria; ids maiores caem na última posição
+constexpr uint32_t HISTOGRAM_BUCKETS = 48;  // Faixa i: [2^(i-1), 2^i) ns; a última vai de 2^46 ns (~19 h) em diante
+
+/*
+MetricsSnapshot
+Função: Soma das métricas de todas as threads em um instante, para exportar (writeJson, writeText) ou consultar.
+*/
+struct MetricsSnapshot {
+    struct HistogramData {
+        uint64_t buckets[HISTOGRAM_BUCKETS] = {};
+        uint64_t count = 0;
+        uint64_t sum = 0;
+
+        // Limite superior (ns) da faixa em que cai o quantil q (0..1); 0 sem amostras
+        uint64_t quantile(double q) const {
+            uint64_t alvo = static_cast<uint64_t>(q * static_cast<double>(count));
+            uint64_t acumulado = 0;
+            for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+                acumulado += buckets[i];
+                if (count > 0 && acumulado > alvo)
+                    return i == 0 ? 0 : (uint64_t(1) << i) - 1;
+            }
+            return count > 0 ? UINT64_MAX : 0;
+        }
+    };
+
+    uint32_t threads = 0;
+    uint64_t counters[static_cast<size_t>(Counter::Count)] = {};
+    uint64_t sceneVisits[METRIC_SCENES] = {};
+    uint64_t sceneNanos[METRIC_SCENES] = {}; // Tempo que os jogadores passaram decidindo em cada cena
+    HistogramData histograms[static_cast<size_t>(Histogram::Count)];
+
+    uint64_t get(Counter c) const { return counters[static_cast<size_t>(c)]; }
+    const HistogramData &get(Histogram h) const { return histograms[static_cast<size_t>(h)]; }
+
+    void writeJson(std::ostream &out) const {
+        out << "{\n  \"threads\": " << threads << ",\n  \"counters\": {";
+        for (size_t i = 0; i < std::size(counters); i++)
+            out << (i ? ", " : "") << '"' << COUNTER_NAMES[i] << "\": " << counters[i];
+        out << "},\n  \"scenes\": [";
+        bool primeira = true;
+        for (uint32_t id = 0; id < METRIC_SCENES; id++) {
+            if (sceneVisits[id] == 0 && sceneNanos[id] == 0)
+                continue;
+            out << (primeira ? "\n" : ",\n") << "    {\"id\": " << id << ", \"visits\": " << sceneVisits[id]
+                << ", \"decision_ns\": " << sceneNanos[id] << "}";
+            primeira = false;
+        }
+        out << (primeira ? "" : "\n  ") << "],\n  \"histograms\": {";
+        for (size_t h = 0; h < std::size(histograms); h++) {
+            const HistogramData &d = histograms[h];
+            out << (h ? "," : "") << "\n    \"" << HISTOGRAM_NAMES[h] << "\": {\"count\": " << d.count << ", \"sum\": " << d.sum
+                << ", \"p50\": " << d.quantile(0.5) << ", \"p90\": " << d.quantile(0.9) << ", \"p99\": " << d.quantile(0.99)
+                << ", \"buckets\": [";
+            for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+                out << (i ? ", " : "") << d.buckets[i];
+            out << "]}";
+        }
+        out << "\n  }\n}\n";
+    }
+
+    void writeText(std::ostream &out) const {
+        out << "threads " << threads << "\n";
+        for (size_t i = 0; i < std::size(counters); i++)
+            out << COUNTER_NAMES[i] << " " << counters[i] << "\n";
+        for (uint32_t id = 0; id < METRIC_SCENES; id++)
+            if (sceneVisits[id] != 0 || sceneNanos[id] != 0)
+                out << "scene " << id << " visits " << sceneVisits[id] << " decision_ns " << sceneNanos[id] << "\n";
+        for (size_t h = 0; h < std::size(histograms); h++) {
+            const HistogramData &d = histograms[h];
+            out << HISTOGRAM_NAMES[h] << " count " << d.count << " sum " << d.sum << " p50 " << d.quantile(0.5)
+                << " p90 " << d.quantile(0.9) << " p99 " << d.quantile(0.99) << "\n";
+        }
+    }
+};
+
+/*
+Metrics
+Função: Métricas de execução (cenas mais visitadas, tempo de decisão dos jogadores, resultados do Evento_Randomico) com custo de poucos nanossegundos por evento.
+Cada thread escreve só no seu próprio bloco de contadores, criado no primeiro uso e nunca liberado (as contagens de threads que terminaram continuam na soma). Como há um único escritor por bloco, um incremento é uma leitura e uma escrita atômicas relaxadas, sem trava e sem instrução "lock"; snapshot() lê todos os blocos sem parar quem escreve. Só a criação de um bloco novo usa uma trava.
+*/
+class Metrics {
+    public:
+        static void count(Counter c, uint64_t n = 1) { add(block().counters[static_cast<size_t>(c)], n); }
+
+        static void visitScene(int sceneId) { add(block().sceneVisits[sceneSlot(sceneId)], 1); }
+
+        // Tempo de decisão em uma cena: entra no histograma ChoiceLatency e no total da cena
+        static void decision(int sceneId, uint64_t nanos) {
+            Block &b = block();
+            add(b.sceneNanos[sceneSlot(sceneId)], nanos);
+            record(b, Histogram::ChoiceLatency, nanos);
+        }
+
+        static void observe(Histogram h, uint64_t nanos) { record(block(), h, nanos); }
+
+        static MetricsSnapshot snapshot() {
+            Registry &r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            MetricsSnapshot s;
+            s.threads = static_cast<uint32_t>(r.blocks.size());
+            for (const Block &b : r.blocks) {
+                for (size_t i = 0; i < std::size(s.counters); i++)
+                    s.counters[i] += b.counters[i].load(std::memory_order_relaxed);
+                for (uint32_t i = 0; i < METRIC_SCENES; i++) {
+                    s.sceneVisits[i] += b.sceneVisits[i].load(std::memory_order_relaxed);
+                    s.sceneNanos[i] += b.sceneNanos[i].load(std::memory_order_relaxed);
+                }
+                for (size_t h = 0; h < std::size(s.histograms); h++) {
+                    const HistogramBlock &hb = b.histograms[h];
+                    MetricsSnapshot::HistogramData &d = s.histograms[h];
+                    for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+                        uint64_t n = hb.buckets[i].load(std::memory_order_relaxed);
+                        d.buckets[i] += n;
+                        d.count += n;
+                    }
+                    d.sum += hb.sum.load(std::memory_order_relaxed);
+                }
+            }
+            return s;
+        }
+
+        // Grava o snapshot atual em "path": JSON se o nome terminar em ".json", texto (uma métrica por linha) nos outros casos
+        static bool exportTo(const std::string &path) {
+            MetricsSnapshot s = snapshot();
+            std::ofstream out(path);
+            if (path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0)
+                s.writeJson(out);
+            else
+                s.writeText(out);
+            return static_cast<bool>(out);
+        }
+
+    private:
+        struct HistogramBlock {
+            std::atomic<uint64_t> buckets[HISTOGRAM_BUCKETS] = {};
+            std::atomic<uint64_t> sum{0};
+        };
+
+        // alignas: blocos de threads diferentes não dividem linhas de cache
+        struct alignas(64) Block {
+            std::atomic<uint64_t> counters[static_cast<size_t>(Counter::Count)] = {};
+            std::atomic<uint64_t> sceneVisits[METRIC_SCENES] = {};
+            std::atomic<uint64_t> sceneNanos[METRIC_SCENES] = {};
+            HistogramBlock histograms[static_cast<size_t>(Histogram::Count)];
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::deque<Block> blocks; // deque: os blocos não mudam de endereço quando outros são criados
+        };
+
+        static Registry &registry() {
+            static Registry r;
+            return r;
+        }
+
+        static Block &block() {
+            thread_local Block &b = [] () -> Block & {
+                Registry &r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                return r.blocks.emplace_back();
+            }();
+            return b;
+        }
+
+        // Só a thread dona escreve no bloco, então não é preciso um fetch_add
+        static void add(std::atomic<uint64_t> &a, uint64_t n) {
+            a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        static void record(Block &b, Histogram h, uint64_t nanos) {
+            HistogramBlock &hb = b.histograms[static_cast<size_t>(h)];
+            add(hb.buckets[std::min<uint32_t>(static_cast<uint32_t>(std::bit_width(nanos)), HISTOGRAM_BUCKETS - 1)], 1);
+            add(hb.sum, nanos);
+        }
+
+        static uint32_t sceneSlot(int sceneId) {
+            return sceneId >= 0 && sceneId < static_cast<int>(METRIC_SCENES) ? static_cast<uint32_t>(sceneId) : METRIC_SCENES - 1;
+        }
+};
@@ -0,0 +1,315 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "jogo_engine.cpp"
+#include "jogo_personagens.cpp"
+#define JOGO_ENCONTROS_SEM_MAIN
+#include "jogo_encontros.cpp"
+
+/*
+Microbenchmarks
+Função: Mede cada caminho quente do motor isoladamente (rolagens, busca e exibição de cenas, descompressão das artes, construção do Game, ataques, conversas, métricas, salas do jogo_encontros) e imprime os resultados em JSON, para comparar execuções e detectar regressões automaticamente.
+Para que os números sejam repetíveis:
+    - os geradores de dados são semeados com valores fixos no início de cada amostra;
+    - a saída dos caminhos medidos vai para um streambuf nulo (nada chega ao terminal) e as entradas vêm de um roteiro fixo;
+    - as pausas do jogo_encontros usam o relógio instantâneo (Ritmo::instantaneo);
+    - cada medição é aquecida, calibrada para que uma amostra dure ao menos ALVO_AMOSTRA e repetida AMOSTRAS vezes; a mediana é o valor de referência.
+Uso: jogo_microbenchmarks [filtro]   (só as medições cujo nome contém "filtro")
+Compile com otimização (ex.: cl /O2 /EHsc /std:c++20 ou g++ -O2 -std=c++20).
+*/
+
+const int AMOSTRAS = 15;
+const std::chrono::milliseconds ALVO_AMOSTRA(10);
+const uint64_t SEMENTE = 42;
+
+// Descarta tudo o que é escrito; faz o papel de /dev/null para o std::cout
+class SaidaNula : public std::streambuf {
+    protected:
+        int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+        std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+};
+
+// Entrega o mesmo roteiro de entradas sem fim: ao chegar ao final, recomeça do início, sem copiar nem alocar
+class EntradaCircular : public std::streambuf {
+    public:
+        explicit EntradaCircular(std::string_view roteiro) : roteiro(roteiro) {}
+
+        // Volta ao início do roteiro (cada amostra lê as mesmas entradas)
+        void reiniciar() { setg(nullptr, nullptr, nullptr); }
+
+    protected:
+        int_type underflow() override {
+            char *inicio = const_cast<char *>(roteiro.data());
+            setg(inicio, inicio, inicio + roteiro.size());
+            return traits_type::to_int_type(*inicio);
+        }
+
+    private:
+        std::string_view roteiro;
+};
+
+struct Medicao {
+    std::string nome;
+    uint64_t iteracoes = 0; // Operações por amostra
+    double mediana = 0, minimo = 0, media = 0, desvio = 0; // ns por operação
+};
+
+// Evita que o compilador descarte o trabalho medido
+volatile long long sumidouro;
+
+/* Mede "corpo(n)", que executa n operações e devolve uma soma qualquer dos resultados.
+n dobra até que uma amostra dure ao menos ALVO_AMOSTRA; a primeira amostra com esse n serve de aquecimento. */
+template <class Corpo>
+Medicao medir(const char *nome, Corpo &&corpo)
+{
+    using Relogio = std::chrono::steady_clock;
+    auto amostra = [&](uint64_t n) {
+        auto inicio = Relogio::now();
+        sumidouro = sumidouro + corpo(n);
+        return std::chrono::duration<double, std::nano>(Relogio::now() - inicio).count();
+    };
+
+    uint64_t n = 1;
+    while (amostra(n) < std::chrono::duration<double, std::nano>(ALVO_AMOSTRA).count() && n < (1ull << 40))
+        n *= 2;
+    amostra(n);
+
+    std::vector<double> tempos(AMOSTRAS);
+    for (double &t : tempos)
+        t = amostra(n) / static_cast<double>(n);
+    std::sort(tempos.begin(), tempos.end());
+
+    Medicao m;
+    m.nome = nome;
+    m.iteracoes = n;
+    m.mediana = tempos[AMOSTRAS / 2];
+    m.minimo = tempos.front();
+    for (double t : tempos)
+        m.media += t / AMOSTRAS;
+    for (double t : tempos)
+        m.desvio += (t - m.media) * (t - m.media) / AMOSTRAS;
+    m.desvio = std::sqrt(m.desvio);
+    return m;
+}
+
+// Monta, pelo caminho de addScene, a mesma história padrão que o Game usa já compilada
+void montarHistoriaPadrao(StoryManager &story)
+{
+    const AssetRegistry &artes = defaultAsciiArts();
+    for (const FixedScene &cena : CENAS_PADRAO) {
+        Scene scene(artes[cena.art], std::string(cena.narrative));
+        for (const FixedChoice &escolha : ESCOLHAS_PADRAO)
+            if (escolha.sceneId == cena.id)
+                scene.addChoice(std::string(escolha.text), escolha.targetSceneId, std::string(escolha.condition), std::string(escolha.effect));
+        scene.setEnding(cena.ending);
+        story.addScene(cena.id, scene);
+    }
+}
+
+void escreverTexto(std::ostream &out, std::string_view texto)
+{
+    out << '"';
+    for (char c : texto) {
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            out << ' ';
+        else
+            out << c;
+    }
+    out << '"';
+}
+
+void escreverJson(std::ostream &out, const std::vector<Medicao> &medicoes)
+{
+    out.precision(4);
+    out << std::fixed << "{\n  \"suite\": \"jogo_microbenchmarks\",\n  \"versao\": 1,\n  \"compilador\": ";
+#if defined(__clang__)
+    escreverTexto(out, "clang " __clang_version__);
+#elif defined(__GNUC__)
+    escreverTexto(out, "gcc " __VERSION__);
+#elif defined(_MSC_VER)
+    escreverTexto(out, "msvc " + std::to_string(_MSC_FULL_VER));
+#else
+    escreverTexto(out, "desconhecido");
+#endif
+    out << ",\n  \"semente\": " << SEMENTE << ",\n  \"amostras\": " << AMOSTRAS
+        << ",\n  \"unidade\": \"ns/op\",\n  \"resultados\": [";
+    for (size_t i = 0; i < medicoes.size(); i++) {
+        const Medicao &m = medicoes[i];
+        out << (i ? ",\n" : "\n") << "    {\"nome\": ";
+        escreverTexto(out, m.nome);
+        out << ", \"iteracoes\": " << m.iteracoes << ", \"mediana\": " << m.mediana << ", \"minimo\": " << m.minimo
+            << ", \"media\": " << m.media << ", \"desvio\": " << m.desvio << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+int main(int argc, char *argv[])
+{
+    std::string_view filtro = argc > 1 ? argv[1] : "";
+    std::vector<Medicao> medicoes;
+    auto executar = [&](const char *nome, auto &&corpo) {
+        if (std::string_view(nome).find(filtro) != std::string_view::npos)
+            medicoes.push_back(medir(nome, corpo));
+    };
+
+    // Tudo o que os caminhos medidos escrevem vai para SaidaNula; o JSON sai no fim, pelo cout original
+    SaidaNula nula;
+    std::streambuf *saidaOriginal = std::cout.rdbuf(&nula);
+
+    executar("roll_dice", [](uint64_t n) {
+        dados_padrao().semear(SEMENTE);
+        long long soma = 0;
+        for (uint64_t i = 0; i < n; i++)
+            soma += roll_dice(d20);
+        return soma;
+    });
+
+    StoryManager story;
+    montarHistoriaPadrao(story);
+    executar("StoryManager::getScene", [&](uint64_t n) {
+        long long soma = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            const Scene *scene = story.getScene(static_cast<int>(i % 40));
+            soma += scene ? static_cast<long long>(scene->getChoices().size()) : 0;
+        }
+        return soma;
+    });
+
+    const Scene *inicial = story.getScene(1);
+    executar("Scene::display (saida nula)", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++)
+            inicial->display();
+        return static_cast<long long>(n);
+    });
+
+    executar("Game::Game", [](uint64_t n) {
+        long long soma = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            Game game;
+            soma += game.getStoryManager().getStartSceneId();
+        }
+        return soma;
+    });
+
+    Game game;
+    const StoryManager &compilada = game.getStoryManager();
+    executar("StoryManager::applyChoice", [&](uint64_t n) {
+        GameSession session;
+        compilada.startSession(session, SEMENTE);
+        long long soma = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            int escolhas = compilada.getVisibleChoiceCount(session);
+            if (escolhas == 0)
+                session.sceneId = compilada.getStartSceneId();
+            else
+                compilada.applyChoice(session, static_cast<int>(i % escolhas) + 1);
+            soma += session.sceneId;
+        }
+        return soma;
+    });
+
+    executar("SessionSnapshot save+restore", [&](uint64_t n) {
+        GameSession session;
+        compilada.startSession(session, SEMENTE);
+        SessionSnapshot snapshot;
+        long long soma = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            compilada.saveSession(session, snapshot);
+            soma += compilada.restoreSession(snapshot, session) == SessionSnapshot::Status::Ok;
+        }
+        return soma;
+    });
+
+    Cavaleiro cavaleiro("Cavaleiro");
+    Monstro monstro("Orgo");
+    executar("FormaDeVida::atacar", [&](uint64_t n) {
+        Dados dados(SEMENTE);
+        long long soma = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            monstro.setVida(100);
+            soma += cavaleiro.atacar(monstro, dados);
+        }
+        return soma;
+    });
+
+    executar("FormaDeVida::receberDano", [&](uint64_t n) {
+        long long soma = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            monstro.setVida(100);
+            monstro.receberDano(static_cast<int>(i & 127));
+            soma += monstro.getVida();
+        }
+        return soma;
+    });
+
+    Aldeao aldeao("Aldeao");
+    const std::string ola = "Olá!";
+    executar("SerHumano::converse", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++)
+            cavaleiro.converse(aldeao, ola);
+        return static_cast<long long>(n);
+    });
+
+    executar("Metrics::count", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++)
+            Metrics::count(Counter::SceneDisplays);
+        return static_cast<long long>(Metrics::snapshot().get(Counter::SceneDisplays));
+    });
+
+    executar("Metrics::decision", [](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++)
+            Metrics::decision(static_cast<int>(i & 63), i);
+        return static_cast<long long>(Metrics::snapshot().get(Histogram::ChoiceLatency).count);
+    });
+
+    std::vector<std::string> artes;
+    for (const FixedArt &art : ARTES_PADRAO)
+        artes.push_back(ArtCodec::compress(art.text));
+    std::string quadro;
+    executar("ArtCodec::appendDecoded (artes padrao)", [&](uint64_t n) {
+        long long soma = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            quadro.clear();
+            for (const std::string &arte : artes)
+                ArtCodec::appendDecoded(quadro, arte);
+            soma += static_cast<long long>(quadro.size());
+        }
+        return soma;
+    });
+
+    executar("Masmorra::sala", [](uint64_t n) {
+        Masmorra masmorra(SEMENTE);
+        long long soma = 0;
+        for (uint64_t i = 0; i < n; i++)
+            soma += masmorra.sala(static_cast<uint32_t>(i & 15), i).acontecimento;
+        return soma;
+    });
+
+    // Salas, respostas às perguntas de sim ou não e uma escolha inválida, repetidas sem fim
+    EntradaCircular roteiro("1 s 2 n 3 s 2 s 1 n x ");
+    std::streambuf *entradaOriginal = std::cin.rdbuf(&roteiro);
+    encontros::Evento_Randomico sala;
+    sala.setRitmo(Ritmo::instantaneo());
+    executar("Evento_Randomico::escolhe_sala", [&](uint64_t n) {
+        dados_padrao().semear(SEMENTE);
+        roteiro.reiniciar();
+        std::cin.clear();
+        long long soma = 0;
+        for (uint64_t i = 0; i < n; i++)
+            soma += sala.escolhe_sala();
+        return soma;
+    });
+    std::cin.rdbuf(entradaOriginal);
+
+    std::cout.rdbuf(saidaOriginal);
+    escreverJson(std::cout, medicoes);
+    return 0;
+}
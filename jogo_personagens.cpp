@@ -2,68 +2,12 @@
 #include <string>
 #include <clocale>
 #include <cmath> // Include cmath for floor function
+#include <string_view>
+#include <type_traits>
+#include <variant>
 
-// Define dice constants
-
-#define coin 2
-#define d4 4
-#define d6 6
-#define d8 8
-#define d10 10
-#define d12 12
-#define d20 20
-#define d100 100
-
-// Function to roll a dice
-int roll_dice(int dice_num)
-{
-  switch (dice_num)
-  {
-  case 2:
-    srand(time(0));
-    dice_num = rand() % coin + 1;
-    break;
-
-  case 4:
-    srand(time(0));
-    dice_num = rand() % d4 + 1;
-    break;
-
-  case 6:
-    srand(time(0));
-    dice_num = rand() % d6 + 1;
-    break;
-
-  case 8:
-    srand(time(0));
-    dice_num = rand() % d8 + 1;
-    break;
-
-  case 10:
-    srand(time(0));
-    dice_num = rand() % d10 + 1;
-    break;
-
-  case 12:
-    srand(time(0));
-    dice_num = rand() % d12 + 1;
-    break;
-
-  case 20:
-    srand(time(0));
-    dice_num = rand() % d20 + 1;
-    break;
-
-  case 100:
-    srand(time(0));
-    dice_num = rand() % d100 + 1;
-    break;
-
-  default:
-    break;
-  }
-  return dice_num;
-}
+#include "jogo_dados.cpp"
+#include "jogo_dialogo.cpp"
 
 using namespace std;
 
@@ -102,10 +46,17 @@ public:
 
   virtual void atacar(FormaDeVida &alvo)
   {
-    int dano = (rand() % static_cast<int>(forca)) + 1;
-    alvo.receberDano(dano);
+    int dano = atacar(alvo, dados_padrao());
     cout << nome << " ataca " << alvo.getNome() << " causando " << dano << " de dano!\n";
   }
+  // Ataque silencioso com o gerador da sessão; retorna o dano causado (1..forca).
+  // Para despacho estático nos laços de simulação, chame com o nome da classe (a.Cavaleiro::atacar(...))
+  virtual int atacar(FormaDeVida &alvo, Dados &dados)
+  {
+    int dano = dados.rolar(static_cast<int>(forca));
+    alvo.receberDano(dano);
+    return dano;
+  }
   void receberDano(int dano)
   {
     vida = vida - dano;
@@ -123,30 +74,37 @@ public:
   SerHumano() : FormaDeVida() {}
   SerHumano(string n) : FormaDeVida(n) {}
 
-  void fale(string s)
+  void fale(std::string_view s)
   {
     cout << getNome() << " diz: " << s << "\n";
   }
 
-  virtual string responda(string s)
+  // Tabela de falas da classe em dialogos_padrao(); cada classe que fala diferente declara a sua
+  static constexpr std::string_view TABELA_DIALOGO = "SerHumano";
+
+  // Id da tabela da classe, procurado uma única vez
+  template <class Classe>
+  static uint32_t tabelaDialogo()
+  {
+    static const uint32_t tabela = dialogos_padrao().procurarTabela(Classe::TABELA_DIALOGO);
+    return tabela;
+  }
+
+  // Resposta da classe "Classe" à fala "s", sem despacho virtual nem cópias
+  template <class Classe>
+  static std::string_view falaDe(std::string_view s)
   {
-    if (s == "Olá!")
-      return "Tudo bem?";
-    else if (s == "Tudo bem?")
-      return "Sim, e você?";
-    else if (s == "Sim, e você?")
-      return "Estou ótimo!";
-    else if (s == "Até logo!")
-      return "Até!";
-    else if (s == "Tchau!")
-      return "Tchau!";
-    else
-      return "Não sei dizer.";
+    const Dialogos &d = dialogos_padrao();
+    return d.texto(d.responder(tabelaDialogo<Classe>(), d.procurar(s)));
   }
 
+  static std::string_view fala(std::string_view s) { return falaDe<SerHumano>(s); }
+
+  virtual string responda(string s) { return string(fala(s)); }
+
   // Conversa interativa entre personagens usando template.
   template <class ClasseTemplate>
-  void converse(ClasseTemplate pessoa, string s)
+  void converse(ClasseTemplate &pessoa, const string &s)
   {
     string respostaPessoa;
     string minhaResposta = s;
@@ -241,21 +199,10 @@ public:
   }
   int getArmadura() { return armadura; }
 
-  virtual string responda(string s)
-  {
-    if (s == "Olá!")
-      return "Como vai, nobre amigo?";
-    else if (s == "Tudo bem?")
-      return "Sim, e como está Vossa senhoria?";
-    else if (s == "Sim, e você?")
-      return "Estou passando muito bem!";
-    else if (s == "Até logo!")
-      return "Até a próxima!";
-    else if (s == "Tchau!")
-      return "Até logo!";
-    else
-      return "Não sei dizer.";
-  }
+  static constexpr std::string_view TABELA_DIALOGO = "Cavaleiro";
+  static std::string_view fala(std::string_view s) { return falaDe<Cavaleiro>(s); }
+
+  string responda(string s) { return string(fala(s)); }
 
   void defender()
   {
@@ -269,8 +216,8 @@ protected:
   int inteligencia, beleza, dinheiro;
 
 public:
-  Princesa() : SerHumano() {}
-  Princesa(string n) : SerHumano(n) {}
+  Princesa() : SerHumano(), inteligencia(100), beleza(100), dinheiro(100) {}
+  Princesa(string n) : SerHumano(n), inteligencia(100), beleza(100), dinheiro(100) {}
 
   void setInteligencia(int i)
   {
@@ -300,8 +247,8 @@ protected:
   int lealdade, honestidade;
 
 public:
-  Aldeao() : SerHumano() {}
-  Aldeao(string n) : SerHumano(n) {}
+  Aldeao() : SerHumano(), lealdade(100), honestidade(100) {}
+  Aldeao(string n) : SerHumano(n), lealdade(100), honestidade(100) {}
 
   void setLealdade(int l)
   {
@@ -317,21 +264,10 @@ public:
   }
   int getHonestidade() { return honestidade; }
 
-  string responda(string s)
-  {
-    if (s == "Olá!")
-      return "To de boa, e você?";
-    else if (s == "Tudo bem?")
-      return "Não é da sua conta!";
-    else if (s == "Sim, e você?")
-      return "Então, larga mão!";
-    else if (s == "Até logo!")
-      return "Se cuida!";
-    else if (s == "Tchau!")
-      return "Tô nem aí!";
-    else
-      return "Não sei dizer.";
-  }
+  static constexpr std::string_view TABELA_DIALOGO = "Aldeao";
+  static std::string_view fala(std::string_view s) { return falaDe<Aldeao>(s); }
+
+  string responda(string s) { return string(fala(s)); }
 };
 
 class Monstro : public FormaDeVida
@@ -340,8 +276,8 @@ protected:
   int simpatia;
 
 public:
-  Monstro() : FormaDeVida() {}
-  Monstro(string n) : FormaDeVida(n) {}
+  Monstro() : FormaDeVida(), simpatia(0) {}
+  Monstro(string n) : FormaDeVida(n), simpatia(0) {}
 
   void setSimpatia(int s)
   {
@@ -357,8 +293,8 @@ protected:
   int fogo;
 
 public:
-  Dragao() : Monstro() {}
-  Dragao(string n) : Monstro(n) {}
+  Dragao() : Monstro(), fogo(100) {}
+  Dragao(string n) : Monstro(n), fogo(100) {}
 
   void setFogo(int f)
   {
@@ -373,3 +309,50 @@ public:
     return alvo.getVida();
   }
 };
+
+/*
+Personagem
+Função: Qualquer um dos personagens guardado por valor em um std::variant, para os laços de simulação: grupos mistos ficam em um vetor contíguo, sem um objeto no heap por personagem, e as ações são resolvidas com std::visit chamando a versão da classe concreta pelo nome (chamada qualificada, sem passar pela vtable), que o compilador pode expandir no laço.
+A API polimórfica (referências para FormaDeVida e SerHumano, atacar e responda virtuais) continua valendo para o restante do jogo.
+*/
+using Personagem = std::variant<Cavaleiro, Mago, Bruxa, Princesa, Aldeao, Monstro, Dragao>;
+
+inline FormaDeVida &formaDeVida(Personagem &p)
+{
+  return std::visit([](auto &c) -> FormaDeVida & { return c; }, p);
+}
+
+inline int atacar(Personagem &atacante, FormaDeVida &alvo, Dados &dados)
+{
+  return std::visit([&](auto &a) {
+    using Classe = std::decay_t<decltype(a)>;
+    return a.Classe::atacar(alvo, dados);
+  }, atacante);
+}
+
+// Resposta do personagem à fala "s"; monstros não conversam
+inline std::string_view responder(const Personagem &p, std::string_view s)
+{
+  return std::visit([&](const auto &c) -> std::string_view {
+    using Classe = std::decay_t<decltype(c)>;
+    if constexpr (std::is_base_of_v<SerHumano, Classe>)
+      return Classe::fala(s);
+    else
+      return "Não sei dizer.";
+  }, p);
+}
+
+// Mesma conversa do SerHumano::converse, com as falas de A e B vindas das tabelas das classes:
+// a conversa anda sobre ids de falas, sem comparar nem copiar textos
+template <class A, class B>
+void conversar(A &a, B &b, std::string_view s)
+{
+  const Dialogos &d = dialogos_padrao();
+  d.conversar(SerHumano::tabelaDialogo<A>(), SerHumano::tabelaDialogo<B>(), d.procurar(s), [&](int quem, uint32_t fala) {
+    std::string_view texto = fala == Dialogos::SEM_FALA ? s : d.texto(fala);
+    if (quem == 0)
+      a.fale(texto);
+    else
+      b.fale(texto);
+  });
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+/*
+Rastreio
+Função: Marca as fases do loop do jogo (busca da cena, exibição, espera pela entrada, transição) e os passos do Evento_Randomico com escopos cronometrados, para ver onde o tempo foi gasto quando uma sessão trava. Os eventos ficam em um buffer circular por thread (os mais antigos são sobrescritos) e TRACE_DUMP grava tudo no formato "trace event" do Chrome, que o Perfetto (ui.perfetto.dev) e o chrome://tracing abrem.
+Só existe quando o programa é compilado com JOGO_RASTREIO definido (ex.: g++ -DJOGO_RASTREIO ou cl /DJOGO_RASTREIO). Sem ele, TRACE_SCOPE e TRACE_DUMP não geram código algum e este arquivo não declara nada.
+
+    TRACE_SCOPE("display");           // evento do ponto da macro até o fim do bloco
+    TRACE_DUMP("jogo_trace.json");    // grava os buffers de todas as threads
+*/
+
+#ifdef JOGO_RASTREIO
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+constexpr uint32_t TRACE_CAPACITY = 1 << 16; // Eventos guardados por thread (potência de 2)
+
+/*
+Tracer
+Função: Buffers circulares dos eventos (nome, início e duração em ns), um por thread, e a exportação deles em JSON. Cada thread escreve só no seu buffer, sem travas; só a criação de um buffer novo usa uma. A exportação deve ser feita com as threads rastreadas paradas (no fim do programa, por exemplo), já que um evento sendo gravado durante a leitura pode sair pela metade.
+*/
+class Tracer {
+    public:
+        struct Event {
+            const char *name; // Literal: só o ponteiro é guardado
+            uint64_t start;   // ns desde o início do processo
+            uint64_t duration;
+        };
+
+        static uint64_t now() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - epoch()).count());
+        }
+
+        static void record(const char *name, uint64_t start, uint64_t end) {
+            Buffer &b = buffer();
+            uint64_t n = b.next.load(std::memory_order_relaxed);
+            b.events[n & (TRACE_CAPACITY - 1)] = {name, start, end - start};
+            b.next.store(n + 1, std::memory_order_release);
+        }
+
+        static void writeJson(std::ostream &out) {
+            Registry &r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+            bool primeiro = true;
+            for (size_t tid = 0; tid < r.buffers.size(); tid++) {
+                const Buffer &b = r.buffers[tid];
+                out << (primeiro ? "\n" : ",\n") << "{\"ph\": \"M\", \"name\": \"thread_name\", \"pid\": 1, \"tid\": " << tid
+                    << ", \"args\": {\"name\": \"thread " << tid << "\"}}";
+                primeiro = false;
+                uint64_t fim = b.next.load(std::memory_order_acquire);
+                uint64_t inicio = fim > TRACE_CAPACITY ? fim - TRACE_CAPACITY : 0;
+                for (uint64_t i = inicio; i < fim; i++) {
+                    const Event &e = b.events[i & (TRACE_CAPACITY - 1)];
+                    // ts e dur em microssegundos, com os nanossegundos na parte fracionária
+                    out << ",\n{\"ph\": \"X\", \"name\": \"" << e.name << "\", \"pid\": 1, \"tid\": " << tid
+                        << ", \"ts\": " << e.start / 1000 << '.' << micros(e.start % 1000)
+                        << ", \"dur\": " << e.duration / 1000 << '.' << micros(e.duration % 1000) << "}";
+                }
+            }
+            out << "\n]}\n";
+        }
+
+        static bool dump(const std::string &path) {
+            std::ofstream out(path);
+            writeJson(out);
+            return static_cast<bool>(out);
+        }
+
+    private:
+        struct Buffer {
+            std::atomic<uint64_t> next{0}; // Total de eventos já gravados
+            Event events[TRACE_CAPACITY];
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::deque<Buffer> buffers; // deque: os buffers não mudam de endereço quando outros são criados
+        };
+
+        static Registry &registry() {
+            static Registry r;
+            return r;
+        }
+
+        static Buffer &buffer() {
+            thread_local Buffer &b = [] () -> Buffer & {
+                Registry &r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                return r.buffers.emplace_back();
+            }();
+            return b;
+        }
+
+        static std::chrono::steady_clock::time_point epoch() {
+            static const std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+            return inicio;
+        }
+
+        // Três dígitos, com zeros à esquerda
+        static std::string micros(uint64_t resto) {
+            std::string s = std::to_string(resto);
+            return std::string(3 - s.size(), '0') + s;
+        }
+};
+
+// Grava um evento com a duração do próprio tempo de vida
+class TraceScope {
+    public:
+        explicit TraceScope(const char *name) : name(name), start(Tracer::now()) {}
+        ~TraceScope() { Tracer::record(name, start, Tracer::now()); }
+        TraceScope(const TraceScope &) = delete;
+        TraceScope &operator=(const TraceScope &) = delete;
+
+    private:
+        const char *name;
+        uint64_t start;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_DUMP(path) Tracer::dump(path)
+
+#else
+
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_DUMP(path) ((void)0)
+
+#endif
@@ -0,0 +1,199 @@
+#pragma once
+#include <cerrno>
+#include <chrono>
+#include <charconv>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "jogo_historia.cpp"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/*
+FrameRenderer
+Função: Monta o quadro inteiro de uma cena (arte, narrativa e lista de escolhas) em um único buffer reaproveitado e o envia com uma só escrita no descritor de saída, no lugar de várias escritas pequenas no std::cout.
+Como o texto de uma cena só depende do grafo, a narrativa e as escolhas são guardadas na primeira exibição; a arte, que pode estar comprimida no grafo, é descomprimida direto no quadro a cada exibição, sem que o cache guarde outra cópia dela.
+Um descritor negativo descarta a saída (útil para medições). Escritas interrompidas por sinal (EINTR) são refeitas; qualquer outro erro interrompe o quadro e é informado a quem pediu a escrita (getError tem o errno).
+*/
+class FrameRenderer {
+    public:
+        // Montagem (appendFrame) e escrita (write) são medidas em separado: um turno pode montar várias cenas e
+        // enviar tudo em uma escrita só
+        struct Stats {
+            uint64_t scenes = 0;       // Quadros de cena montados
+            uint64_t cacheHits = 0;
+            uint64_t composeNanos = 0;
+            uint64_t writes = 0;
+            uint64_t totalBytes = 0;   // Bytes escritos
+            uint64_t writeNanos = 0;
+            size_t lastWriteBytes = 0;
+            uint64_t lastWriteNanos = 0;
+        };
+
+        explicit FrameRenderer(int fd = 1) : fd(fd) {}
+
+        // Troca o descritor de saída (negativo descarta os quadros)
+        void setOutput(int novo) { fd = novo; }
+
+        // Descarta os quadros guardados (ex.: depois de carregar outra história)
+        void clearCache() {
+            cache.clear();
+            cachedGraph = nullptr;
+        }
+
+        // Exibe a cena "id" do grafo com uma única escrita; false se a escrita falhar
+        bool renderScene(const StoryGraph &graph, int id) {
+            return write(composeScene(graph, id));
+        }
+
+        // Texto completo do quadro da cena em um buffer de trabalho, válido até a próxima chamada
+        std::string_view composeScene(const StoryGraph &graph, int id, uint32_t visible = 0xFFFFFFFFu) {
+            scratch.clear();
+            appendFrame(scratch, graph, id, visible);
+            return scratch;
+        }
+
+        /* Acrescenta a "out" o quadro da cena listando só as escolhas de "visible" (bit i = escolha i), numeradas de
+        1 em diante. A arte é descomprimida direto em "out" a cada quadro; o cache guarda só o resto do quadro
+        (narrativa e escolhas), montado na primeira exibição, e não uma cópia descomprimida de cada arte. Em cenas
+        com condições que escondem alguma escolha o resto é montado na hora. Retorna false se a arte estiver
+        corrompida; o quadro sai sem ela. */
+        bool appendFrame(std::string &out, const StoryGraph &graph, int id, uint32_t visible = 0xFFFFFFFFu) {
+            auto inicio = std::chrono::steady_clock::now();
+            bool artOk = composeFrame(out, graph, id, visible);
+            stats.scenes++;
+            stats.composeNanos += elapsedNanos(inicio);
+            return artOk;
+        }
+
+        // Monta o quadro da cena no fim de "out", no mesmo formato do Scene::display; false se a arte estiver corrompida
+        static bool appendScene(std::string &out, const StoryGraph &graph, int id, uint32_t visible = 0xFFFFFFFFu) {
+            out.reserve(out.size() + graph.getArtSize(id) + textSize(graph, id));
+            bool artOk = graph.appendArt(id, out); // Descomprime a arte direto no quadro
+            appendText(out, graph, id, visible);
+            return artOk;
+        }
+
+        // Envia um quadro já montado (ex.: a saída de um turno inteiro) com uma escrita; false se a escrita falhar
+        bool write(std::string_view text) {
+            auto inicio = std::chrono::steady_clock::now();
+            bool ok = writeFrame(text);
+            uint64_t nanos = elapsedNanos(inicio);
+            stats.writes++;
+            stats.totalBytes += text.size();
+            stats.writeNanos += nanos;
+            stats.lastWriteBytes = text.size();
+            stats.lastWriteNanos = nanos;
+            return ok;
+        }
+
+        // errno da última escrita que falhou (0 se nenhuma falhou)
+        int getError() const { return error; }
+
+        const Stats &getStats() const { return stats; }
+
+        // Resumo das medições: tempo médio de montagem por cena, bytes e tempo médios por escrita
+        void printStats(std::ostream &out) const {
+            out << "Cenas montadas: " << stats.scenes << " (" << stats.cacheHits << " do cache)";
+            if (stats.scenes > 0)
+                out << ", " << stats.composeNanos / stats.scenes << " ns/cena";
+            out << "\nEscritas: " << stats.writes;
+            if (stats.writes > 0)
+                out << ", " << stats.totalBytes / stats.writes << " bytes/escrita, "
+                    << stats.writeNanos / stats.writes << " ns/escrita";
+            out << "\n";
+        }
+
+    private:
+        bool composeFrame(std::string &out, const StoryGraph &graph, int id, uint32_t visible) {
+            int count = graph.getChoiceCount(id);
+            uint32_t all = count >= 32 ? 0xFFFFFFFFu : (1u << count) - 1;
+            if (graph.isConditional(id) && (visible & all) != all)
+                return appendScene(out, graph, id, visible);
+            if (cachedGraph != &graph) {
+                cache.assign(graph.getSceneSlots(), std::string());
+                cachedGraph = &graph;
+            }
+            std::string &text = cache[id];
+            if (text.empty())
+                appendText(text, graph, id);
+            else
+                stats.cacheHits++;
+            out.reserve(out.size() + graph.getArtSize(id) + text.size());
+            bool artOk = graph.appendArt(id, out); // Descomprime a arte direto no quadro
+            out.append(text);
+            return artOk;
+        }
+
+        // Tamanho máximo do que vem depois da arte
+        static size_t textSize(const StoryGraph &graph, int id) {
+            int count = graph.getChoiceCount(id);
+            size_t size = graph.getNarrative(id).size() + 2 + (count > 0 ? 11 : 0);
+            for (int i = 0; i < count; i++)
+                size += graph.getChoiceText(id, i).size() + 16;
+            return size;
+        }
+
+        // O que vem depois da arte: narrativa e escolhas visíveis
+        static void appendText(std::string &out, const StoryGraph &graph, int id, uint32_t visible = 0xFFFFFFFFu) {
+            int count = graph.getChoiceCount(id);
+            out.reserve(out.size() + textSize(graph, id));
+            out.append("\n").append(graph.getNarrative(id)).append("\n");
+            if (count > 0 && visible != 0) {
+                out.append("\nEscolhas:\n");
+                int number = 1;
+                for (int i = 0; i < count; i++)
+                    if (i >= 32 || (visible >> i & 1u))
+                        appendNumber(out, number++).append(": ").append(graph.getChoiceText(id, i)).append("\n");
+            }
+        }
+
+        static std::string &appendNumber(std::string &out, int value) {
+            char digits[16];
+            auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            return out.append(digits, result.ptr);
+        }
+
+        bool writeFrame(std::string_view frame) {
+            if (fd < 0)
+                return true;
+            // O que ainda estiver no buffer do std::cout precisa sair antes do quadro
+            std::cout.flush();
+            const char *data = frame.data();
+            size_t remaining = frame.size();
+            while (remaining > 0) {
+#ifdef _WIN32
+                int written = _write(fd, data, static_cast<unsigned int>(remaining));
+#else
+                ssize_t written = ::write(fd, data, remaining);
+#endif
+                if (written < 0 && errno == EINTR)
+                    continue;
+                if (written <= 0) {
+                    error = written < 0 ? errno : EIO; // Nenhum byte escrito sem erro: o descritor não aceita mais nada
+                    return false;
+                }
+                data += written;
+                remaining -= static_cast<size_t>(written);
+            }
+            return true;
+        }
+
+        static uint64_t elapsedNanos(std::chrono::steady_clock::time_point inicio) {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - inicio).count());
+        }
+
+        int fd;
+        int error = 0;
+        const StoryGraph *cachedGraph = nullptr;
+        std::vector<std::string> cache;
+        std::string scratch;
+        Stats stats;
+};
@@ -0,0 +1,76 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include "jogo_engine.cpp"
+
+/*
+Repetidor de partidas
+Função: Reproduz sem terminal uma partida gravada com jogo --gravar jogo.rpl (ver ReplayLog) sobre a mesma história, confere se ela chega ao mesmo estado final e mede quantas reproduções por segundo o ReplayRunner faz. Com um passo, mostra o estado da partida naquele ponto, saltando pelo checkpoint mais próximo.
+
+Uso:
+    jogo_repetidor jogo.rpl
+    jogo_repetidor jogo.rpl <passo>
+*/
+
+static const char *nomeStatus(ReplayRunner::Status status)
+{
+    switch (status) {
+    case ReplayRunner::Status::Ok: return "ok";
+    case ReplayRunner::Status::OtherStory: return "o registro é de outra história";
+    case ReplayRunner::Status::BadEvent: return "escolha inválida no registro";
+    case ReplayRunner::Status::Mismatch: return "estado final diferente do gravado";
+    }
+    return "?";
+}
+
+static void mostrarSessao(const GameSession &session)
+{
+    std::cout << "Cena " << session.sceneId << ", ";
+    for (int i = 0; i < WORLD_STATS; i++)
+        std::cout << WORLD_STAT_NAMES[i] << " " << session.world.stats[i] << (i + 1 < WORLD_STATS ? ", " : "\n");
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Uso: " << argv[0] << " <partida.rpl> [passo]\n";
+        return 1;
+    }
+    ReplayLog log;
+    if (!log.load(argv[1])) {
+        std::cerr << "Não foi possível ler o registro " << argv[1] << "\n";
+        return 1;
+    }
+    Game game("historia.bin");
+    ReplayRunner runner(game.getStoryManager());
+    GameSession session;
+
+    if (argc == 3) {
+        uint32_t step = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10));
+        ReplayRunner::Status status = runner.seek(log, step, session);
+        std::cout << "Passo " << step << " de " << log.getEventCount() << ": " << nomeStatus(status) << "\n";
+        mostrarSessao(session);
+        return status == ReplayRunner::Status::Ok ? 0 : 1;
+    }
+
+    ReplayRunner::Status status = runner.verify(log, session);
+    std::cout << log.getEventCount() << " eventos, " << log.getCheckpoints().size() << " checkpoints, semente "
+              << log.getSeed() << ": " << nomeStatus(status) << (log.hasFinalState() ? "" : " (partida sem estado final)") << "\n";
+    mostrarSessao(session);
+    if (status != ReplayRunner::Status::Ok)
+        return 1;
+
+    // Reproduções em sequência por meio segundo
+    auto inicio = std::chrono::steady_clock::now();
+    auto fim = inicio + std::chrono::milliseconds(500);
+    uint64_t reproducoes = 0;
+    while (std::chrono::steady_clock::now() < fim) {
+        for (int i = 0; i < 1000; i++)
+            runner.replay(log, session);
+        reproducoes += 1000;
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    std::cout << static_cast<uint64_t>(reproducoes / segundos) << " reproduções/s\n";
+    return 0;
+}
@@ -0,0 +1,270 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "jogo_sessao.cpp"
+
+constexpr char REPLAY_MAGIC[4] = {'R', 'P', 'L', 'Y'};
+constexpr uint32_t REPLAY_VERSION = 1;
+constexpr uint32_t REPLAY_RESTORE = 0; // Evento seguido de um SessionSnapshot (a partida foi carregada de um save)
+constexpr size_t REPLAY_HEADER_SIZE = 40 + SNAPSHOT_SIZE;
+
+/*
+ReplayLog
+Função: Registro compacto de uma partida, para reproduzi-la exatamente (bugs relatados por jogadores, auditoria de resultados): a semente inicial do gerador de dados e a sequência de entradas do jogador, cada uma gravada como um inteiro de tamanho variável (1 byte para valores até 127). Como o jogo é determinístico a partir da semente, isso basta para refazer a partida.
+A cada "checkpointInterval" eventos o registro guarda também um SessionSnapshot do estado antes do evento e a posição dele nos bytes, para que o reprodutor salte para qualquer passo sem refazer a partida desde o início. Eventos que trocam a sessão inteira (carregar um save) são gravados como REPLAY_RESTORE seguido da cópia restaurada.
+Formato do arquivo (inteiros em little-endian):
+
+    0   "RPLY", versão, história (StoryGraph::getFingerprint, 0 fora do Game)
+    12  semente (uint64)
+    20  intervalo dos checkpoints, quantidade de eventos, tamanho dos eventos em bytes, quantidade de checkpoints
+    36  1 se há estado final gravado, seguido do SessionSnapshot final
+    88  eventos, depois os checkpoints (passo, posição nos eventos, SessionSnapshot)
+*/
+class ReplayLog {
+    public:
+        struct Checkpoint {
+            uint32_t step;
+            uint32_t offset;
+            SessionSnapshot snapshot;
+        };
+
+        explicit ReplayLog(uint32_t checkpointInterval = 64) : checkpointInterval(checkpointInterval) {}
+
+        // Começa um registro novo para uma partida com a semente "seed" na história "story"
+        void begin(uint64_t seed, uint32_t story) {
+            this->seed = seed;
+            this->story = story;
+            events.clear();
+            checkpoints.clear();
+            eventCount = 0;
+            hasFinal = false;
+        }
+
+        // O próximo evento cai em um passo de checkpoint (ver addCheckpoint)
+        bool checkpointDue() const { return checkpointInterval > 0 && eventCount > 0 && eventCount % checkpointInterval == 0; }
+
+        // Guarda o estado "before", em que o próximo evento será aplicado
+        void addCheckpoint(const GameSession &before) {
+            Checkpoint c{eventCount, static_cast<uint32_t>(events.size()), SessionSnapshot()};
+            c.snapshot.save(before, story);
+            checkpoints.push_back(c);
+        }
+
+        // Uma entrada do jogador (valor maior que 0; o significado é de quem grava e de quem reproduz)
+        void record(uint32_t value) {
+            do {
+                uint8_t byte = value & 0x7F;
+                value >>= 7;
+                events.push_back(byte | (value ? 0x80 : 0));
+            } while (value);
+            eventCount++;
+        }
+
+        // A sessão foi trocada inteira por "after" (ex.: carregar um save)
+        void recordRestore(const GameSession &after) {
+            record(REPLAY_RESTORE);
+            SessionSnapshot snapshot;
+            snapshot.save(after, story);
+            events.insert(events.end(), snapshot.data(), snapshot.data() + snapshot.size());
+        }
+
+        // Estado depois do último evento gravado, conferido pelo reprodutor
+        void recordState(const GameSession &end) {
+            finalState.save(end, story);
+            hasFinal = true;
+        }
+
+        uint64_t getSeed() const { return seed; }
+        uint32_t getStory() const { return story; }
+        uint32_t getEventCount() const { return eventCount; }
+        const std::vector<uint8_t> &getEvents() const { return events; }
+        const std::vector<Checkpoint> &getCheckpoints() const { return checkpoints; }
+        bool hasFinalState() const { return hasFinal; }
+        const SessionSnapshot &getFinalState() const { return finalState; }
+
+        // Último checkpoint no passo "step" ou antes dele; nullptr se não houver
+        const Checkpoint *findCheckpoint(uint32_t step) const {
+            size_t lo = 0, hi = checkpoints.size();
+            while (lo < hi) {
+                size_t mid = (lo + hi) / 2;
+                if (checkpoints[mid].step <= step)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return lo > 0 ? &checkpoints[lo - 1] : nullptr;
+        }
+
+        void write(std::vector<uint8_t> &out) const {
+            out.clear();
+            out.reserve(REPLAY_HEADER_SIZE + events.size() + checkpoints.size() * (8 + SNAPSHOT_SIZE));
+            out.insert(out.end(), REPLAY_MAGIC, REPLAY_MAGIC + 4);
+            put32(out, REPLAY_VERSION);
+            put32(out, story);
+            put64(out, seed);
+            put32(out, checkpointInterval);
+            put32(out, eventCount);
+            put32(out, static_cast<uint32_t>(events.size()));
+            put32(out, static_cast<uint32_t>(checkpoints.size()));
+            put32(out, hasFinal ? 1 : 0);
+            out.insert(out.end(), finalState.data(), finalState.data() + finalState.size());
+            out.insert(out.end(), events.begin(), events.end());
+            for (const Checkpoint &c : checkpoints) {
+                put32(out, c.step);
+                put32(out, c.offset);
+                out.insert(out.end(), c.snapshot.data(), c.snapshot.data() + c.snapshot.size());
+            }
+        }
+
+        // Lê um registro gravado por write; retorna false (e deixa o registro vazio) se ele estiver incompleto ou se
+        // os checkpoints não apontarem, em ordem, para o início de eventos
+        bool read(const uint8_t *data, size_t size) {
+            begin(0, 0);
+            if (size < REPLAY_HEADER_SIZE || std::memcmp(data, REPLAY_MAGIC, 4) != 0 || get32(data + 4) != REPLAY_VERSION)
+                return false;
+            uint32_t eventBytes = get32(data + 28);
+            uint32_t checkpointCount = get32(data + 32);
+            if (size != REPLAY_HEADER_SIZE + eventBytes + uint64_t(checkpointCount) * (8 + SNAPSHOT_SIZE))
+                return false;
+            story = get32(data + 8);
+            seed = get64(data + 12);
+            checkpointInterval = get32(data + 20);
+            eventCount = get32(data + 24);
+            hasFinal = get32(data + 36) != 0;
+            std::memcpy(finalState.data(), data + 40, SNAPSHOT_SIZE);
+            const uint8_t *p = data + REPLAY_HEADER_SIZE;
+            events.assign(p, p + eventBytes);
+            p += eventBytes;
+            checkpoints.resize(checkpointCount);
+            for (Checkpoint &c : checkpoints) {
+                c.step = get32(p);
+                c.offset = get32(p + 4);
+                std::memcpy(c.snapshot.data(), p + 8, SNAPSHOT_SIZE);
+                p += 8 + SNAPSHOT_SIZE;
+            }
+            if (!checkpointsMatchEvents()) {
+                begin(0, 0);
+                return false;
+            }
+            return true;
+        }
+
+        bool save(const std::string &path) const {
+            std::vector<uint8_t> bytes;
+            write(bytes);
+            std::ofstream out(path, std::ios::binary);
+            out.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            return static_cast<bool>(out);
+        }
+
+        bool load(const std::string &path) {
+            std::ifstream in(path, std::ios::binary);
+            if (!in)
+                return false;
+            std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            return read(bytes.data(), bytes.size());
+        }
+
+    private:
+        /* Percorre os eventos conferindo que cada checkpoint, em ordem estritamente crescente de passo, está no início
+        do evento do seu passo, e que os eventos terminam inteiros, na quantidade gravada. Sem isso um arquivo
+        corrompido faria o ReplayCursor começar no meio de um evento e reproduzir um estado errado. */
+        bool checkpointsMatchEvents() const {
+            for (size_t i = 1; i < checkpoints.size(); i++)
+                if (checkpoints[i].step <= checkpoints[i - 1].step)
+                    return false;
+            size_t offset = 0, next = 0;
+            uint32_t step = 0;
+            while (true) {
+                if (next < checkpoints.size() && checkpoints[next].step == step) {
+                    if (checkpoints[next++].offset != offset)
+                        return false;
+                }
+                if (offset == events.size())
+                    break;
+                uint32_t value = 0;
+                bool complete = false;
+                for (int shift = 0; offset < events.size() && shift < 32 && !complete; shift += 7) {
+                    uint8_t byte = events[offset++];
+                    value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                    complete = !(byte & 0x80);
+                }
+                if (!complete)
+                    return false;
+                if (value == REPLAY_RESTORE) {
+                    if (events.size() - offset < SNAPSHOT_SIZE)
+                        return false;
+                    offset += SNAPSHOT_SIZE;
+                }
+                step++;
+            }
+            return next == checkpoints.size() && step == eventCount;
+        }
+
+        static void put32(std::vector<uint8_t> &out, uint32_t v) {
+            for (int i = 0; i < 4; i++)
+                out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+        }
+        static void put64(std::vector<uint8_t> &out, uint64_t v) {
+            put32(out, static_cast<uint32_t>(v));
+            put32(out, static_cast<uint32_t>(v >> 32));
+        }
+        static uint32_t get32(const uint8_t *p) { return p[0] | p[1] << 8 | p[2] << 16 | static_cast<uint32_t>(p[3]) << 24; }
+        static uint64_t get64(const uint8_t *p) { return get32(p) | static_cast<uint64_t>(get32(p + 4)) << 32; }
+
+        uint64_t seed = 0;
+        uint32_t story = 0;
+        uint32_t checkpointInterval;
+        uint32_t eventCount = 0;
+        std::vector<uint8_t> events;
+        std::vector<Checkpoint> checkpoints;
+        bool hasFinal = false;
+        SessionSnapshot finalState;
+};
+
+/*
+ReplayCursor
+Função: Lê os eventos de um ReplayLog em ordem, a partir do início ou de um checkpoint, sem copiar nada.
+*/
+class ReplayCursor {
+    public:
+        explicit ReplayCursor(const ReplayLog &log) : events(log.getEvents()) {}
+        ReplayCursor(const ReplayLog &log, const ReplayLog::Checkpoint &from)
+            : events(log.getEvents()), offset(from.offset), step(from.step) {}
+
+        // Próximo evento; false no fim do registro ou se os bytes estiverem truncados
+        bool next(uint32_t &value) {
+            value = 0;
+            for (int shift = 0; offset < events.size() && shift < 32; shift += 7) {
+                uint8_t byte = events[offset++];
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) {
+                    step++;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Cópia que acompanha um evento REPLAY_RESTORE
+        bool nextSnapshot(SessionSnapshot &snapshot) {
+            if (events.size() - offset < SNAPSHOT_SIZE)
+                return false;
+            std::memcpy(snapshot.data(), events.data() + offset, SNAPSHOT_SIZE);
+            offset += SNAPSHOT_SIZE;
+            return true;
+        }
+
+        // Eventos já lidos (o passo em que o próximo evento será aplicado)
+        uint32_t getStep() const { return step; }
+
+    private:
+        const std::vector<uint8_t> &events;
+        size_t offset = 0;
+        uint32_t step = 0;
+};
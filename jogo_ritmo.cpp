@@ -0,0 +1,94 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+/*
+Ritmo
+Função: Camada de apresentação que dá ritmo ao texto (reticências, pausas dramáticas) sem colocar esperas dentro da lógica do jogo. A lógica só marca a pausa no texto de saída com marcarPausa(saida, ms); quem mostra esse texto no terminal o faz com exibir(), que espera em cada marca, e quem o manda para outro lugar (rede, testes) tira as marcas com semPausas(). Assim uma pausa de uma sessão nunca segura a thread em que outras sessões andam (ver AgendadorSessoes). O relógio escolhido decide quanto tempo de fato passa:
+
+    Real         espera a duração pedida (jogador no terminal)
+    Instantaneo  não espera nada (simulações, reproduções e testes rodam na velocidade da CPU)
+    Acelerado    espera a duração dividida pelo fator (demonstrações)
+
+Antes de esperar, o texto pendente do stream é enviado, então a pausa acontece entre o que já foi mostrado e o que vem depois. O tempo pedido é somado mesmo no relógio instantâneo, para medir quanto uma partida duraria para o jogador.
+*/
+class Ritmo {
+    public:
+        enum class Relogio { Real, Instantaneo, Acelerado };
+
+        explicit Ritmo(Relogio relogio = Relogio::Real, double fator = 1.0)
+            : relogio(relogio), fator(fator > 0 ? fator : 1.0) {}
+
+        static Ritmo real() { return Ritmo(Relogio::Real); }
+        static Ritmo instantaneo() { return Ritmo(Relogio::Instantaneo); }
+        static Ritmo acelerado(double fator) { return Ritmo(Relogio::Acelerado, fator); }
+
+        // Caractere de controle (ASCII GS) que delimita as marcas; nunca aparece no texto do jogo
+        static constexpr char MARCA = '\x1d';
+
+        // Marca em "saida" uma pausa entre o texto que já está nela e o que vier depois
+        static void marcarPausa(std::string &saida, uint32_t milissegundos) {
+            saida += MARCA;
+            saida += std::to_string(milissegundos);
+            saida += MARCA;
+        }
+
+        // Mostra "saida" em "out", fazendo as pausas marcadas nela
+        void exibir(std::string_view saida, std::ostream &out = std::cout) {
+            size_t inicio = 0, marca;
+            while ((marca = saida.find(MARCA, inicio)) != std::string_view::npos) {
+                size_t fim = saida.find(MARCA, marca + 1);
+                if (fim == std::string_view::npos)
+                    break;
+                out << saida.substr(inicio, marca - inicio);
+                uint32_t milissegundos = 0;
+                for (char c : saida.substr(marca + 1, fim - marca - 1))
+                    milissegundos = milissegundos * 10 + static_cast<uint32_t>(c - '0');
+                esperar(milissegundos, out);
+                inicio = fim + 1;
+            }
+            out << saida.substr(inicio);
+        }
+
+        // O texto sem as marcas, para quem não espera
+        static std::string semPausas(std::string_view saida) {
+            std::string texto;
+            texto.reserve(saida.size());
+            bool dentro = false;
+            for (char c : saida) {
+                if (c == MARCA)
+                    dentro = !dentro;
+                else if (!dentro)
+                    texto += c;
+            }
+            return texto;
+        }
+
+        // Pausa direta, para quem já está escrevendo no std::cout
+        void pausa(uint32_t milissegundos) { esperar(milissegundos, std::cout); }
+
+        Relogio getRelogio() const { return relogio; }
+
+        // Soma das pausas pedidas, independente do relógio
+        std::chrono::milliseconds getTempoPedido() const { return tempoPedido; }
+
+    private:
+        void esperar(uint32_t milissegundos, std::ostream &out) {
+            tempoPedido += std::chrono::milliseconds(milissegundos);
+            if (relogio == Relogio::Instantaneo || milissegundos == 0)
+                return;
+            out.flush();
+            std::chrono::duration<double, std::milli> espera(milissegundos);
+            if (relogio == Relogio::Acelerado)
+                espera /= fator;
+            std::this_thread::sleep_for(espera);
+        }
+
+        Relogio relogio;
+        double fator;
+        std::chrono::milliseconds tempoPedido{0};
+};
@@ -0,0 +1,275 @@
+#include <iostream>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "jogo_engine.cpp"
+
+/*
+Servidor de sessões
+Função: Hospeda a aventura para muitos jogadores em um único processo. Cada conexão (TCP em localhost ou socket Unix) roda o mesmo fluxo Game::play do jogo de terminal, como uma corrotina suspensa enquanto espera a escolha do jogador; um único laço epoll atende todas as conexões, sem uma thread ou um std::cin bloqueado por jogador.
+O jogador envia o número da escolha seguido de Enter e recebe o quadro da próxima cena. A sessão guarda o quadro da corrotina (com a GameSession dentro), a linha parcial digitada e a saída ainda não enviada; o buffer de saída é liberado assim que termina de ser enviado, então sessões ociosas não o mantêm.
+Para milhares de conexões, aumente o limite de descritores (ulimit -n).
+
+Uso:
+    jogo_servidor 4000              (TCP em 127.0.0.1:4000)
+    jogo_servidor /tmp/jogo.sock    (socket Unix)
+*/
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <csignal>
+#include <fcntl.h>
+#include <memory>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+struct Sessao
+{
+    Tarefa<> fluxo;              // Game::play desta conexão
+    CanalEntrada canal;          // Onde o fluxo espera a próxima escolha
+    std::string saida;           // Texto produzido pelo fluxo e ainda não enviado
+    size_t enviado = 0;
+    bool descartando = false;    // Linha longa demais: ignora até o próximo '\n'
+    uint8_t tamanhoEntrada = 0;
+    char entrada[32];            // Bytes recebidos e ainda não processados
+
+    bool saidaPendente() const { return enviado < saida.size(); }
+};
+
+class Servidor
+{
+public:
+    explicit Servidor(Game &game) : game(game) {}
+
+    bool escutar(const std::string &endereco)
+    {
+        bool unixSocket = endereco.find('/') != std::string::npos;
+        ouvinte = socket(unixSocket ? AF_UNIX : AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        if (ouvinte < 0)
+            return false;
+        if (unixSocket)
+        {
+            sockaddr_un addr;
+            std::memset(&addr, 0, sizeof(addr));
+            addr.sun_family = AF_UNIX;
+            std::strncpy(addr.sun_path, endereco.c_str(), sizeof(addr.sun_path) - 1);
+            unlink(endereco.c_str());
+            if (bind(ouvinte, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0)
+                return false;
+        }
+        else
+        {
+            int sim = 1;
+            setsockopt(ouvinte, SOL_SOCKET, SO_REUSEADDR, &sim, sizeof(sim));
+            sockaddr_in addr;
+            std::memset(&addr, 0, sizeof(addr));
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(static_cast<uint16_t>(std::atoi(endereco.c_str())));
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            if (bind(ouvinte, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0)
+                return false;
+        }
+        if (listen(ouvinte, SOMAXCONN) != 0)
+            return false;
+        epoll = epoll_create1(0);
+        epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.fd = ouvinte;
+        return epoll >= 0 && epoll_ctl(epoll, EPOLL_CTL_ADD, ouvinte, &ev) == 0;
+    }
+
+    void executar()
+    {
+        std::vector<epoll_event> eventos(1024);
+        size_t ultimoRelatorio = static_cast<size_t>(-1);
+        while (true)
+        {
+            int n = epoll_wait(epoll, eventos.data(), static_cast<int>(eventos.size()), 10000);
+            for (int i = 0; i < n; i++)
+            {
+                int fd = eventos[i].data.fd;
+                if (fd == ouvinte)
+                    aceitar();
+                else if (eventos[i].events & (EPOLLERR | EPOLLHUP))
+                    fechar(fd);
+                else
+                {
+                    if (eventos[i].events & EPOLLOUT)
+                        enviar(fd);
+                    if (sessoes[fd] && !sessoes[fd]->saidaPendente())
+                        receber(fd);
+                }
+            }
+            if (n == 0 && ativas != ultimoRelatorio)
+            {
+                relatorio();
+                ultimoRelatorio = ativas;
+            }
+        }
+    }
+
+    // Memória das sessões dentro do processo (os buffers de socket ficam no kernel)
+    void relatorio() const
+    {
+        size_t corrotinas = ativas > 0 ? Tarefa<>::bytesEmUso() / ativas : 0;
+        std::cout << "Sessões ativas: " << ativas << " | " << sizeof(Sessao) + corrotinas << " bytes por sessão ("
+                  << sizeof(Sessao) << " de estado + " << corrotinas << " do quadro da corrotina) | "
+                  << sessoes.capacity() * sizeof(sessoes[0]) / 1024 << " KiB na tabela de sessões" << std::endl;
+    }
+
+private:
+    void aceitar()
+    {
+        while (true)
+        {
+            int fd = accept4(ouvinte, nullptr, nullptr, SOCK_NONBLOCK);
+            if (fd < 0)
+                return;
+            if (static_cast<size_t>(fd) >= sessoes.size())
+                sessoes.resize(fd + 1024);
+            sessoes[fd].reset(new Sessao());
+            Sessao &s = *sessoes[fd];
+            ativas++;
+
+            epoll_event ev;
+            ev.events = EPOLLIN;
+            ev.data.fd = fd;
+            epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &ev);
+            s.fluxo = game.play(s.canal, s.saida);
+            s.fluxo.iniciar();
+            enviar(fd);
+        }
+    }
+
+    // Processa as linhas recebidas uma a uma. Enquanto a resposta de uma linha não tiver sido
+    // enviada por completo, nada mais é lido: o restante fica no buffer do kernel.
+    void receber(int fd)
+    {
+        while (sessoes[fd] && !sessoes[fd]->saidaPendente())
+        {
+            Sessao &s = *sessoes[fd];
+            if (processarEntrada(fd))
+                continue;
+            if (s.tamanhoEntrada == sizeof(s.entrada))
+            {
+                s.descartando = true;
+                s.tamanhoEntrada = 0;
+            }
+            ssize_t lidos = read(fd, s.entrada + s.tamanhoEntrada, sizeof(s.entrada) - s.tamanhoEntrada);
+            if (lidos == 0 || (lidos < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+            {
+                fechar(fd);
+                return;
+            }
+            if (lidos < 0)
+                return;
+            s.tamanhoEntrada = static_cast<uint8_t>(s.tamanhoEntrada + lidos);
+        }
+    }
+
+    // Consome uma linha completa do buffer da sessão e a entrega ao fluxo; retorna false se ainda não há '\n'
+    bool processarEntrada(int fd)
+    {
+        Sessao &s = *sessoes[fd];
+        const char *fim = static_cast<const char *>(std::memchr(s.entrada, '\n', s.tamanhoEntrada));
+        if (fim == nullptr)
+            return false;
+        size_t tamanho = static_cast<size_t>(fim - s.entrada);
+        std::string_view linha(s.entrada, tamanho);
+        if (!linha.empty() && linha.back() == '\r')
+            linha.remove_suffix(1);
+        // Uma linha longa demais chega ao fluxo como entrada vazia, que ele trata como opção inválida
+        s.canal.fornecer(s.descartando ? std::string() : std::string(linha));
+        s.descartando = false;
+        size_t resto = s.tamanhoEntrada - tamanho - 1;
+        std::memmove(s.entrada, fim + 1, resto);
+        s.tamanhoEntrada = static_cast<uint8_t>(resto);
+        enviar(fd);
+        return true;
+    }
+
+    void enviar(int fd)
+    {
+        Sessao &s = *sessoes[fd];
+        while (s.saidaPendente())
+        {
+            ssize_t enviados = write(fd, s.saida.data() + s.enviado, s.saida.size() - s.enviado);
+            if (enviados < 0)
+            {
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    esperarEscrita(fd, true);
+                    return;
+                }
+                fechar(fd);
+                return;
+            }
+            s.enviado += static_cast<size_t>(enviados);
+        }
+        std::string().swap(s.saida);
+        s.enviado = 0;
+        esperarEscrita(fd, false);
+        if (s.fluxo.concluida())
+            fechar(fd);
+    }
+
+    void esperarEscrita(int fd, bool esperar)
+    {
+        epoll_event ev;
+        ev.events = esperar ? EPOLLOUT : EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(epoll, EPOLL_CTL_MOD, fd, &ev);
+    }
+
+    void fechar(int fd)
+    {
+        if (!sessoes[fd])
+            return;
+        sessoes[fd].reset();
+        ativas--;
+        epoll_ctl(epoll, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+    }
+
+    Game &game;
+    std::vector<std::unique_ptr<Sessao>> sessoes; // Indexado pelo descritor da conexão
+    size_t ativas = 0;
+    int ouvinte = -1;
+    int epoll = -1;
+};
+
+int main(int argc, char **argv)
+{
+    std::string endereco = argc > 1 ? argv[1] : "4000";
+    signal(SIGPIPE, SIG_IGN);
+
+    Game game("historia.bin");
+    game.setSavePath(""); // Um único arquivo de save seria compartilhado por todos os jogadores
+    game.setMetricsPath(""); // Um cliente não pode gravar arquivos no servidor nem travar o loop do epoll com E/S de disco
+    Servidor servidor(game);
+    if (!servidor.escutar(endereco))
+    {
+        std::cerr << "Não foi possível escutar em " << endereco << ": " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    std::cout << "Servidor escutando em " << endereco << "\n";
+    servidor.relatorio();
+    servidor.executar();
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    std::cerr << "O servidor de sessões usa epoll e só está disponível no Linux.\n";
+    return 1;
+}
+
+#endif
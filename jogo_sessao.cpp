@@ -0,0 +1,116 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "jogo_dados.cpp"
+#include "jogo_decisoes.cpp"
+
+/*
+GameSession
+Função: Estado de uma partida em andamento: a cena atual, o estado do mundo (marcadores de decisões e atributos do personagem, ver WorldState) e o gerador de dados da sessão. É pequeno e não aloca, então um processo pode manter milhares de sessões sobre o mesmo StoryManager.
+O gerador começa com a semente 0; StoryManager::startSession escolhe a semente da partida.
+*/
+struct GameSession {
+    int sceneId = 1;
+    WorldState world;
+    Dados dados{0};
+};
+
+constexpr uint8_t SNAPSHOT_MAGIC[2] = {'S', 'V'};
+constexpr uint8_t SNAPSHOT_VERSION = 1;
+constexpr size_t SNAPSHOT_SIZE = 48;
+static_assert(WORLD_STATS == 4, "o formato do SessionSnapshot guarda 4 atributos");
+
+/*
+SessionSnapshot
+Função: Cópia binária de tamanho fixo (48 bytes) de uma GameSession, para salvar e retomar partidas ou para servir de ponto de reinício em execuções longas sem terminal. Gravar e restaurar são cópias de alguns campos, sem alocações; os bytes podem ir direto para um arquivo ou para a rede.
+Formato (inteiros em little-endian, independente da máquina):
+
+    0   "SV", versão (1 byte), reservado (1 byte)
+    4   identificação da história (StoryGraph::getFingerprint)
+    8   cena atual (int32)
+    12  atributos do WorldState (4 x int16)
+    20  marcadores do WorldState (uint64)
+    28  semente e estado do gerador de dados (2 x uint64)
+    44  soma de verificação (FNV-1a dos 44 bytes anteriores)
+
+A restauração recusa cópias de outra versão, corrompidas ou de outra história, sem alterar a sessão.
+*/
+class SessionSnapshot {
+    public:
+        enum class Status { Ok, BadMagic, BadVersion, BadChecksum, OtherStory };
+
+        // Grava a sessão; "story" identifica a história em que ela está sendo jogada
+        void save(const GameSession &session, uint32_t story) {
+            bytes[0] = SNAPSHOT_MAGIC[0];
+            bytes[1] = SNAPSHOT_MAGIC[1];
+            bytes[2] = SNAPSHOT_VERSION;
+            bytes[3] = 0;
+            put32(4, story);
+            put32(8, static_cast<uint32_t>(session.sceneId));
+            for (int i = 0; i < 4; i++)
+                put16(12 + 2 * i, static_cast<uint16_t>(session.world.stats[i]));
+            put64(20, session.world.flags);
+            put64(28, session.dados.getSemente());
+            put64(36, session.dados.getEstado());
+            put32(44, checksum());
+        }
+
+        // Confere a cópia e, se ela for válida para a história "story", substitui o conteúdo da sessão
+        Status restore(GameSession &session, uint32_t story) const {
+            Status status = check(story);
+            if (status != Status::Ok)
+                return status;
+            session.sceneId = static_cast<int32_t>(get32(8));
+            for (int i = 0; i < 4; i++)
+                session.world.stats[i] = static_cast<int16_t>(get16(12 + 2 * i));
+            session.world.flags = get64(20);
+            session.dados.semear(get64(28));
+            session.dados.setEstado(get64(36));
+            return Status::Ok;
+        }
+
+        Status check(uint32_t story) const {
+            if (bytes[0] != SNAPSHOT_MAGIC[0] || bytes[1] != SNAPSHOT_MAGIC[1])
+                return Status::BadMagic;
+            if (bytes[2] != SNAPSHOT_VERSION)
+                return Status::BadVersion;
+            if (get32(44) != checksum())
+                return Status::BadChecksum;
+            if (get32(4) != story)
+                return Status::OtherStory;
+            return Status::Ok;
+        }
+
+        // Cena gravada, sem restaurar a sessão (a cópia precisa ter passado por check)
+        int getSceneId() const { return static_cast<int32_t>(get32(8)); }
+
+        uint8_t *data() { return bytes; }
+        const uint8_t *data() const { return bytes; }
+        static constexpr size_t size() { return SNAPSHOT_SIZE; }
+
+    private:
+        uint32_t checksum() const {
+            uint32_t hash = 2166136261u;
+            for (size_t i = 0; i < 44; i++)
+                hash = (hash ^ bytes[i]) * 16777619u;
+            return hash;
+        }
+
+        void put16(size_t at, uint16_t v) {
+            bytes[at] = static_cast<uint8_t>(v);
+            bytes[at + 1] = static_cast<uint8_t>(v >> 8);
+        }
+        void put32(size_t at, uint32_t v) {
+            put16(at, static_cast<uint16_t>(v));
+            put16(at + 2, static_cast<uint16_t>(v >> 16));
+        }
+        void put64(size_t at, uint64_t v) {
+            put32(at, static_cast<uint32_t>(v));
+            put32(at + 4, static_cast<uint32_t>(v >> 32));
+        }
+        uint16_t get16(size_t at) const { return static_cast<uint16_t>(bytes[at] | bytes[at + 1] << 8); }
+        uint32_t get32(size_t at) const { return get16(at) | static_cast<uint32_t>(get16(at + 2)) << 16; }
+        uint64_t get64(size_t at) const { return get32(at) | static_cast<uint64_t>(get32(at + 4)) << 32; }
+
+        uint8_t bytes[SNAPSHOT_SIZE] = {};
+};
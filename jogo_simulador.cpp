@@ -0,0 +1,188 @@
+#include <iostream>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include "jogo_personagens.cpp"
+
+/*
+Simulador de combates (Monte Carlo)
+Função: Estima o equilíbrio dos duelos entre FormaDeVida (ex.: Cavaleiro x Dragao, Mago x Bruxa) repetindo milhões de lutas independentes em todos os núcleos.
+Cada luta usa FormaDeVida::atacar/receberDano em sua versão silenciosa. As lutas são divididas em blocos distribuídos dinamicamente entre as threads; cada bloco tem seu próprio fluxo de Dados derivado da semente, então o resultado é o mesmo qualquer que seja o número de threads.
+
+Uso: jogo_simulador [lutas] [threads] [semente]
+*/
+
+const int LIMITE_TURNOS = 1000;     // Ataques por luta antes de declarar empate
+const uint64_t LUTAS_POR_BLOCO = 1 << 16;
+const unsigned MAX_THREADS = 256;   // Mais threads que isso só disputam os mesmos núcleos
+
+struct ResultadoSimulacao
+{
+    uint64_t lutas = 0;
+    uint64_t vitoriasA = 0;
+    uint64_t vitoriasB = 0;
+    uint64_t empates = 0;
+    std::vector<uint64_t> turnos = std::vector<uint64_t>(LIMITE_TURNOS + 1, 0); // Ataques até a morte
+    uint64_t vidaRestante[101] = {0}; // Vida do vencedor ao fim da luta
+
+    void somar(const ResultadoSimulacao &outro)
+    {
+        lutas += outro.lutas;
+        vitoriasA += outro.vitoriasA;
+        vitoriasB += outro.vitoriasB;
+        empates += outro.empates;
+        for (size_t i = 0; i < turnos.size(); i++)
+            turnos[i] += outro.turnos[i];
+        for (int i = 0; i <= 100; i++)
+            vidaRestante[i] += outro.vidaRestante[i];
+    }
+
+    // Percentil (0..100) da vida restante do vencedor
+    int percentilVida(double p) const
+    {
+        uint64_t total = vitoriasA + vitoriasB;
+        if (total == 0)
+            return 0;
+        uint64_t alvo = static_cast<uint64_t>(p / 100.0 * (total - 1)) + 1;
+        uint64_t acumulado = 0;
+        for (int i = 0; i <= 100; i++)
+        {
+            acumulado += vidaRestante[i];
+            if (acumulado >= alvo)
+                return i;
+        }
+        return 100;
+    }
+};
+
+// Uma luta: "a" ataca primeiro e os dois se alternam até um morrer ou o limite de turnos.
+// Os ataques são chamados pelo nome da classe, sem despacho virtual
+template <class A, class B>
+void lutar(A &a, B &b, Dados &dados, ResultadoSimulacao &resultado)
+{
+    int turno = 0;
+    while (turno < LIMITE_TURNOS)
+    {
+        turno++;
+        a.A::atacar(b, dados);
+        if (!b.estaVivo())
+        {
+            resultado.vitoriasA++;
+            resultado.vidaRestante[a.getVida()]++;
+            break;
+        }
+        turno++;
+        b.B::atacar(a, dados);
+        if (!a.estaVivo())
+        {
+            resultado.vitoriasB++;
+            resultado.vidaRestante[b.getVida()]++;
+            break;
+        }
+    }
+    if (turno >= LIMITE_TURNOS && a.estaVivo() && b.estaVivo())
+        resultado.empates++;
+    resultado.turnos[turno < LIMITE_TURNOS ? turno : LIMITE_TURNOS]++;
+    resultado.lutas++;
+}
+
+// Executa "lutas" duelos entre cópias de modeloA e modeloB usando "threads" threads
+template <class A, class B>
+ResultadoSimulacao simular(const A &modeloA, const B &modeloB, uint64_t lutas, unsigned threads, uint64_t semente)
+{
+    std::atomic<uint64_t> proximoBloco(0);
+    uint64_t blocos = (lutas + LUTAS_POR_BLOCO - 1) / LUTAS_POR_BLOCO;
+    ResultadoSimulacao total;
+    std::mutex mutexTotal;
+
+    auto trabalhador = [&]()
+    {
+        ResultadoSimulacao local;
+        Dados dados;
+        while (true)
+        {
+            uint64_t bloco = proximoBloco.fetch_add(1, std::memory_order_relaxed);
+            if (bloco >= blocos)
+                break;
+            dados.semear(Dados::derivar(semente, bloco));
+            uint64_t fim = (bloco + 1) * LUTAS_POR_BLOCO < lutas ? (bloco + 1) * LUTAS_POR_BLOCO : lutas;
+            for (uint64_t i = bloco * LUTAS_POR_BLOCO; i < fim; i++)
+            {
+                A a = modeloA;
+                B b = modeloB;
+                lutar(a, b, dados, local);
+            }
+        }
+        std::lock_guard<std::mutex> trava(mutexTotal);
+        total.somar(local);
+    };
+
+    std::vector<std::thread> trabalhadores;
+    for (unsigned t = 1; t < threads; t++)
+        trabalhadores.emplace_back(trabalhador);
+    trabalhador();
+    for (std::thread &t : trabalhadores)
+        t.join();
+    return total;
+}
+
+template <class A, class B>
+void relatorio(const A &modeloA, const B &modeloB, uint64_t lutas, unsigned threads, uint64_t semente)
+{
+    auto inicio = std::chrono::steady_clock::now();
+    ResultadoSimulacao r = simular(modeloA, modeloB, lutas, threads, semente);
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    A a = modeloA;
+    B b = modeloB;
+    cout << a.getNome() << " x " << b.getNome() << " (" << r.lutas << " lutas, "
+         << r.lutas / segundos / 1e6 << " milhões de lutas/s)\n";
+    cout << "  Vitória " << a.getNome() << ": " << 100.0 * r.vitoriasA / r.lutas << "%\n";
+    cout << "  Vitória " << b.getNome() << ": " << 100.0 * r.vitoriasB / r.lutas << "%\n";
+    cout << "  Empates: " << 100.0 * r.empates / r.lutas << "%\n";
+    cout << "  Vida restante do vencedor (p10/p50/p90/p99): " << r.percentilVida(10) << " / "
+         << r.percentilVida(50) << " / " << r.percentilVida(90) << " / " << r.percentilVida(99) << "\n";
+    cout << "  Ataques até a morte:\n";
+    for (size_t t = 0; t < r.turnos.size(); t++)
+        if (r.turnos[t] > 0)
+            cout << "    " << t << ": " << 100.0 * r.turnos[t] / r.lutas << "%\n";
+    cout << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t lutas = argc > 1 ? strtoull(argv[1], nullptr, 10) : 10000000;
+    unsigned threads = std::thread::hardware_concurrency();
+    if (argc > 2)
+    {
+        // strtoul aceitaria "-1" (e o transformaria em um número enorme), então o texto precisa começar por um dígito
+        char *fim = nullptr;
+        unsigned long pedidas = isdigit(static_cast<unsigned char>(argv[2][0])) ? strtoul(argv[2], &fim, 10) : 0;
+        if (pedidas == 0 || *fim != '\0')
+        {
+            cerr << "Número de threads inválido: " << argv[2] << " (use um inteiro positivo)\n";
+            return 1;
+        }
+        if (pedidas > MAX_THREADS)
+        {
+            cerr << "Usando " << MAX_THREADS << " threads, o máximo\n";
+            pedidas = MAX_THREADS;
+        }
+        threads = static_cast<unsigned>(pedidas);
+    }
+    uint64_t semente = argc > 3 ? strtoull(argv[3], nullptr, 10) : 2025;
+    if (threads == 0)
+        threads = 1;
+
+    cout << "Simulando com " << threads << " thread(s), semente " << semente << "\n\n";
+    relatorio(Cavaleiro("Cavaleiro"), Dragao("Dragao"), lutas, threads, semente);
+    relatorio(Mago("Mago"), Bruxa("Bruxa"), lutas, threads, semente);
+    relatorio(Aldeao("Aldeao"), Monstro("Monstro"), lutas, threads, semente);
+    return 0;
+}